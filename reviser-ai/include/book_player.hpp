@@ -0,0 +1,43 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_BOOK_PLAYER_HPP
+#define REVISER_AI_BOOK_PLAYER_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "board.hpp"
+#include "opening_book.hpp"
+#include "player.hpp"
+
+namespace reviser::ai {
+
+// Plays the moves of an opening book and asks the wrapped player for moves in
+// positions that are not in the book. The wrapped player should not be used
+// directly while it belongs to a `BookPlayer`, since it takes over its color.
+class BookPlayer final : public Player
+{
+public:
+    BookPlayer(std::shared_ptr<Player> player, std::shared_ptr<const OpeningBook> book);
+
+    void new_game() override;
+
+    [[nodiscard]] Position pick_move(const BasicBoard& board) const override;
+
+    void game_over(const GameResult& result) override;
+
+    [[nodiscard]] const Player& get_player() const { return *player; }
+
+    // Number of moves since the start of the game that were taken from the book.
+    [[nodiscard]] std::uint32_t get_num_book_moves() const { return num_book_moves; }
+
+private:
+    std::shared_ptr<Player> player;
+    std::shared_ptr<const OpeningBook> book;
+    mutable std::uint32_t num_book_moves{};
+};
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_BOOK_PLAYER_HPP
@@ -0,0 +1,117 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_ENDGAME_SOLVER_HPP
+#define REVISER_AI_ENDGAME_SOLVER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "position.hpp"
+#include "position_set.hpp"
+#include "search.hpp"
+#include "transposition_table.hpp"
+
+namespace reviser::ai {
+
+struct EndgameResult
+{
+    std::optional<Position> best_move{};
+    // Final number of discs of the player to move minus those of the opponent, with
+    // perfect play by both sides. Empty fields are not counted, as in `Score`.
+    int disc_difference{};
+    SearchStatistics statistics{};
+};
+
+// Exact solver for endgame positions. The position is converted to a pair of
+// bitboards; the last four empty fields are handled by specialised routines, and
+// moves are ordered by parity and by the mobility they leave for the opponent.
+// Results for positions with many empty fields are kept in a transposition table
+// that is reused by later calls to `solve()`.
+class EndgameSolver
+{
+public:
+    explicit EndgameSolver(
+        std::size_t transposition_table_size_in_mb = TranspositionTable::default_size_in_mb);
+
+    template <BasicBoardType BoardT>
+    [[nodiscard]] EndgameResult solve(const BoardT& board, PlayerColor pc) const;
+
+    [[nodiscard]] EndgameResult solve(Bits player, Bits opponent) const;
+
+private:
+    std::shared_ptr<TranspositionTable> transposition_table;
+};
+
+// Parallel version of `EndgameSolver` that splits the search tree between threads
+// following the Young Brothers Wait concept: once the eldest child of a node is
+// searched, its siblings are offered to idle threads through work-stealing deques,
+// and a beta cutoff aborts the searches of the remaining siblings. The threads
+// share a transposition table that is reused by later calls to `solve()`.
+class ParallelEndgameSolver
+{
+public:
+    explicit ParallelEndgameSolver(
+        std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u),
+        std::size_t transposition_table_size_in_mb = TranspositionTable::default_size_in_mb);
+
+    [[nodiscard]] std::size_t get_num_threads() const { return num_threads; }
+
+    template <BasicBoardType BoardT>
+    [[nodiscard]] EndgameResult solve(const BoardT& board, PlayerColor pc) const;
+
+    [[nodiscard]] EndgameResult solve(Bits player, Bits opponent) const;
+
+private:
+    std::size_t num_threads;
+    std::shared_ptr<TranspositionTable> transposition_table;
+};
+
+// All fields of `player` that can never be flipped again, no matter how the game
+// continues.
+[[nodiscard]] Bits find_stable_bits(Bits player, Bits opponent);
+
+// The fields of the player with color `pc` and of the opponent.
+template <BasicBoardType BoardT>
+[[nodiscard]] std::pair<Bits, Bits> find_player_bits(const BoardT& board, const PlayerColor pc)
+{
+    const auto player_field = field_for_player_color(pc);
+    const auto opponent_field = field_for_player_color(other_player_color(pc));
+    auto player = Bits{};
+    auto opponent = Bits{};
+    for (const auto pos : all_board_positions()) {
+        if (const Field field = board[pos]; field == player_field) {
+            player |= position_bit(pos);
+        }
+        else if (field == opponent_field) {
+            opponent |= position_bit(pos);
+        }
+    }
+    return {player, opponent};
+}
+
+template <BasicBoardType BoardT>
+EndgameResult EndgameSolver::solve(const BoardT& board, const PlayerColor pc) const
+{
+    const auto [player, opponent] = find_player_bits(board, pc);
+    return solve(player, opponent);
+}
+
+template <BasicBoardType BoardT>
+EndgameResult ParallelEndgameSolver::solve(const BoardT& board, const PlayerColor pc) const
+{
+    const auto [player, opponent] = find_player_bits(board, pc);
+    return solve(player, opponent);
+}
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_ENDGAME_SOLVER_HPP
@@ -0,0 +1,113 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_EVALUATION_HPP
+#define REVISER_AI_EVALUATION_HPP
+
+#include <array>
+#include <concepts>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "position.hpp"
+
+namespace reviser::ai {
+
+// Scores of finished games dominate all heuristic evaluations.
+constexpr int win_score{100'000};
+
+// Static values of the fields: corners are valuable, the fields next to them dangerous.
+// clang-format off
+constexpr std::array<int, 64> field_values{
+    100, -20,  10,   5,   5,  10, -20, 100,
+    -20, -50,  -2,  -2,  -2,  -2, -50, -20,
+     10,  -2,  -1,  -1,  -1,  -1,  -2,  10,
+      5,  -2,  -1,  -1,  -1,  -1,  -2,   5,
+      5,  -2,  -1,  -1,  -1,  -1,  -2,   5,
+     10,  -2,  -1,  -1,  -1,  -1,  -2,  10,
+    -20, -50,  -2,  -2,  -2,  -2, -50, -20,
+    100, -20,  10,   5,   5,  10, -20, 100,
+};
+// clang-format on
+
+constexpr int mobility_weight{5};
+
+[[nodiscard]] constexpr int field_value(const Position pos)
+{
+    return field_values[pos.to_linear_index()];
+}
+
+// The value of a finished game with score `score` from the point of view of `pc`.
+[[nodiscard]] inline int terminal_score(const Score score, const PlayerColor pc)
+{
+    const auto disc_difference = score.get_num_fields_for(pc)
+                                 - score.get_num_fields_for(other_player_color(pc));
+    if (disc_difference > 0) {
+        return win_score + disc_difference;
+    }
+    if (disc_difference < 0) {
+        return -win_score + disc_difference;
+    }
+    return 0;
+}
+
+// Heuristic value of a position from the point of view of `pc`, based on the values
+// of the occupied fields and on the difference in mobility.
+template <BoardType BoardT>
+[[nodiscard]] int evaluate_position(const BoardT& board, const PlayerColor pc)
+{
+    const auto player_field = field_for_player_color(pc);
+    auto result = 0;
+    for (const auto pos : all_board_positions()) {
+        if (const Field field = board[pos]; field == player_field) {
+            result += field_value(pos);
+        }
+        else if (field != Field::empty) {
+            result -= field_value(pos);
+        }
+    }
+    const auto player_mobility = static_cast<int>(board.find_valid_moves(pc).size());
+    const auto opponent_mobility
+        = static_cast<int>(board.find_valid_moves(other_player_color(pc)).size());
+    return result + mobility_weight * (player_mobility - opponent_mobility);
+}
+
+// An evaluation function for the search. The search announces the board it starts
+// from with `set_board()` and every move it plays or takes back, so that evaluators
+// can keep incrementally updated state.
+template <typename EvaluatorT, typename BoardT>
+concept EvaluatorFor = std::copyable<EvaluatorT>
+                       && requires(
+                           EvaluatorT evaluator,
+                           const BoardT& board,
+                           const FlipRecord& record,
+                           PlayerColor pc) {
+                              evaluator.set_board(board);
+                              evaluator.play_move(record);
+                              evaluator.undo_move(record);
+                              // clang-format off
+    { evaluator.evaluate(board, pc) } -> std::convertible_to<int>;
+                              // clang-format on
+                          };
+
+// Evaluates positions with `evaluate_position()`; has no state.
+class FieldValueEvaluator
+{
+public:
+    template <BoardType BoardT>
+    void set_board(const BoardT& board)
+    {}
+
+    void play_move(const FlipRecord& record) {}
+    void undo_move(const FlipRecord& record) {}
+
+    template <BoardType BoardT>
+    [[nodiscard]] int evaluate(const BoardT& board, const PlayerColor pc) const
+    {
+        return evaluate_position(board, pc);
+    }
+};
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_EVALUATION_HPP
@@ -0,0 +1,92 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_LAZY_SMP_PLAYER_HPP
+#define REVISER_AI_LAZY_SMP_PLAYER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "board.hpp"
+#include "evaluation.hpp"
+#include "lazy_smp_search.hpp"
+#include "player.hpp"
+#include "search.hpp"
+
+namespace reviser::ai {
+
+// A computer player that picks its moves with `LazySmpSearch` on `num_threads`
+// threads. The transposition table is kept between moves.
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT = FieldValueEvaluator>
+class LazySmpPlayer final
+    : public Player
+    , public SearchTotalsSource
+{
+public:
+    explicit LazySmpPlayer(
+        const std::string_view name = "Lazy SMP player",
+        const SearchLimits limits = {},
+        const std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u),
+        const PlayerColor pc = PlayerColor::dark,
+        std::shared_ptr<TranspositionTable> transposition_table = {},
+        const EvaluatorT& evaluator = {})
+        : Player{name, pc}
+        , search{limits, num_threads, std::move(transposition_table), evaluator}
+    {}
+
+    void new_game() override { total_statistics = {}; }
+
+    [[nodiscard]] Position pick_move(const BasicBoard& board) const override
+    {
+        return pick_move(copy_board_as<BoardT>(board));
+    }
+
+    // Statically dispatched version of `pick_move()` that searches `board` without
+    // converting it.
+    [[nodiscard]] Position pick_move(const BoardT& board) const
+    {
+        const auto result = search.search(board, get_color());
+        if (!result.best_move) {
+            throw std::invalid_argument("Lazy SMP player has no valid move.");
+        }
+        last_statistics = result.statistics;
+        total_statistics += result.statistics;
+        search_totals.add(result.statistics);
+        return *result.best_move;
+    }
+
+    [[nodiscard]] std::size_t get_num_threads() const { return search.get_num_threads(); }
+
+    [[nodiscard]] const SearchLimits& get_limits() const { return search.get_limits(); }
+    void set_limits(const SearchLimits limits) { search.set_limits(limits); }
+
+    // Statistics of the most recent call to `pick_move()`.
+    [[nodiscard]] const SearchStatistics& get_last_statistics() const
+    {
+        return last_statistics;
+    }
+
+    // Statistics accumulated over all moves since the start of the current game.
+    [[nodiscard]] const SearchStatistics& get_total_statistics() const
+    {
+        return total_statistics;
+    }
+
+    // Totals of all searches since the player was created.
+    [[nodiscard]] SearchTotals get_search_totals() const override { return search_totals; }
+
+private:
+    mutable LazySmpSearch<BoardT, EvaluatorT> search;
+    mutable SearchStatistics last_statistics{};
+    mutable SearchStatistics total_statistics{};
+    mutable SearchTotals search_totals{};
+};
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_LAZY_SMP_PLAYER_HPP
@@ -0,0 +1,111 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_LAZY_SMP_SEARCH_HPP
+#define REVISER_AI_LAZY_SMP_SEARCH_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "evaluation.hpp"
+#include "search.hpp"
+#include "transposition_table.hpp"
+
+namespace reviser::ai {
+
+// Parallel alpha-beta search in the style of "Lazy SMP": every thread runs the full
+// iterative deepening search from the root, and the threads communicate only
+// through the shared transposition table. Helper threads search odd numbers of
+// plies deeper and try the root moves in a different order, so that they fill the
+// table with results the main thread needs soon. The result is that of the main
+// thread; the helpers are stopped when it finishes.
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT = FieldValueEvaluator>
+class LazySmpSearch
+{
+public:
+    explicit LazySmpSearch(
+        const SearchLimits limits = {},
+        const std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u),
+        std::shared_ptr<TranspositionTable> transposition_table = {},
+        const EvaluatorT& evaluator = {})
+        : transposition_table{
+              transposition_table ? std::move(transposition_table)
+                                  : std::make_shared<TranspositionTable>()}
+    {
+        if (num_threads == 0) {
+            throw std::invalid_argument("A parallel search needs at least one thread.");
+        }
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            auto& search = searches.emplace_back(limits, this->transposition_table, evaluator);
+            search.set_thread_settings(
+                {static_cast<int>(i % 2),
+                 (i + 1) / 2,
+                 i == 0 ? nullptr : &is_stopped,
+                 false});
+        }
+    }
+
+    LazySmpSearch(const LazySmpSearch&) = delete;
+    LazySmpSearch& operator=(const LazySmpSearch&) = delete;
+
+    [[nodiscard]] std::size_t get_num_threads() const { return searches.size(); }
+
+    [[nodiscard]] const SearchLimits& get_limits() const { return searches.front().get_limits(); }
+    void set_limits(const SearchLimits limits)
+    {
+        for (auto& search : searches) {
+            search.set_limits(limits);
+        }
+    }
+
+    [[nodiscard]] const std::shared_ptr<TranspositionTable>&
+    get_transposition_table() const
+    {
+        return transposition_table;
+    }
+
+    // The statistics of the result are those of the main thread, except for the
+    // nodes, which are counted for all threads.
+    [[nodiscard]] SearchResult search(const BoardT& board, PlayerColor pc);
+
+private:
+    std::shared_ptr<TranspositionTable> transposition_table;
+    std::vector<AlphaBetaSearch<BoardT, EvaluatorT>> searches{};
+    std::atomic<bool> is_stopped{};
+};
+
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT>
+SearchResult LazySmpSearch<BoardT, EvaluatorT>::search(const BoardT& board, const PlayerColor pc)
+{
+    transposition_table->new_search();
+    is_stopped.store(false, std::memory_order_relaxed);
+
+    auto helper_nodes = std::vector<std::uint64_t>(searches.size());
+    auto result = SearchResult{};
+    {
+        auto helpers = std::vector<std::jthread>{};
+        for (std::size_t i = 1; i < searches.size(); ++i) {
+            helpers.emplace_back([this, &board, pc, &nodes = helper_nodes[i], i] {
+                nodes = searches[i].search(board, pc).statistics.nodes;
+            });
+        }
+        result = searches.front().search(board, pc);
+        is_stopped.store(true, std::memory_order_relaxed);
+    }
+    for (const auto nodes : helper_nodes) {
+        result.statistics.nodes += nodes;
+    }
+    return result;
+}
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_LAZY_SMP_SEARCH_HPP
@@ -0,0 +1,137 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_MCTS_PLAYER_HPP
+#define REVISER_AI_MCTS_PLAYER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "player.hpp"
+#include "position.hpp"
+#include "position_set.hpp"
+
+namespace reviser::ai {
+
+struct MctsLimits
+{
+    std::uint64_t max_playouts{10'000};
+    std::chrono::milliseconds max_time{std::chrono::milliseconds::max()};
+    std::size_t num_threads{1};
+    // Capacity of the node pool, which is allocated once. When the pool is full, the
+    // tree is no longer expanded but playouts continue from its leaves.
+    std::size_t max_nodes{1 << 20};
+    double exploration{1.4};
+};
+
+struct MctsStatistics
+{
+    std::uint64_t playouts{};
+    // Playouts through the root that were kept from earlier searches.
+    std::uint64_t reused_playouts{};
+    std::size_t num_nodes{};
+    std::chrono::nanoseconds elapsed_time{};
+
+    [[nodiscard]] double get_playouts_per_second() const;
+    [[nodiscard]] std::string to_string() const;
+
+    MctsStatistics& operator+=(const MctsStatistics& other);
+};
+
+struct MctsResult
+{
+    std::optional<Position> best_move{};
+    MctsStatistics statistics{};
+};
+
+// Monte Carlo tree search with UCT and random playouts. The nodes are allocated from
+// a fixed pool; several threads search the same tree, with atomic visit and value
+// counters. A thread counts its visit when it passes a node on the way down and adds
+// the result on the way up, so that pending playouts count as losses and other
+// threads are steered to different parts of the tree (virtual loss). The tree is
+// kept between searches: if the new position is in the tree, its subtree is reused.
+class MctsSearch
+{
+public:
+    explicit MctsSearch(MctsLimits limits = {}, std::uint64_t seed = 0);
+    ~MctsSearch();
+
+    MctsSearch(const MctsSearch&) = delete;
+    MctsSearch& operator=(const MctsSearch&) = delete;
+
+    [[nodiscard]] const MctsLimits& get_limits() const { return limits; }
+    void set_limits(const MctsLimits& new_limits);
+
+    [[nodiscard]] MctsResult search(Bits player, Bits opponent);
+
+    // Discards the tree.
+    void clear();
+
+private:
+    struct Node;
+    class Worker;
+
+    MctsLimits limits;
+    std::unique_ptr<Node[]> nodes;
+    std::atomic<std::uint32_t> num_nodes{0};
+    std::uint32_t root;
+    std::uint64_t seed;
+
+    [[nodiscard]] std::uint32_t find_or_create_root(Bits player, Bits opponent);
+    [[nodiscard]] std::uint32_t allocate_nodes(std::uint32_t count);
+    void initialize_node(std::uint32_t index, Bits player, Bits opponent, std::uint8_t move);
+    // Adds the children of a leaf. Returns false if another thread is expanding the
+    // node or the pool is full.
+    bool expand(std::uint32_t index);
+};
+
+// A computer player that picks the move with the most playouts of `MctsSearch`.
+class MctsPlayer final : public Player
+{
+public:
+    // Seeds the playouts from `std::random_device`.
+    explicit MctsPlayer(
+        std::string_view name = "MCTS player",
+        const MctsLimits& limits = {},
+        PlayerColor pc = PlayerColor::dark);
+
+    MctsPlayer(
+        std::string_view name, const MctsLimits& limits, std::uint64_t seed, PlayerColor pc)
+        : Player{name, pc}
+        , search{limits, seed}
+    {}
+
+    void new_game() override;
+
+    [[nodiscard]] Position pick_move(const BasicBoard& board) const override;
+
+    [[nodiscard]] const MctsLimits& get_limits() const { return search.get_limits(); }
+    void set_limits(const MctsLimits& limits) { search.set_limits(limits); }
+
+    // Statistics of the most recent call to `pick_move()`.
+    [[nodiscard]] const MctsStatistics& get_last_statistics() const { return last_statistics; }
+
+    // Statistics accumulated over all moves since the start of the current game.
+    [[nodiscard]] const MctsStatistics& get_total_statistics() const
+    {
+        return total_statistics;
+    }
+
+private:
+    mutable MctsSearch search;
+    mutable MctsStatistics last_statistics{};
+    mutable MctsStatistics total_statistics{};
+};
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_MCTS_PLAYER_HPP
@@ -0,0 +1,129 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_OPENING_BOOK_HPP
+#define REVISER_AI_OPENING_BOOK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "bit_board.hpp"
+#include "board.hpp"
+#include "common.hpp"
+#include "game_record.hpp"
+#include "mapped_file.hpp"
+#include "position.hpp"
+#include "position_set.hpp"
+#include "symmetry.hpp"
+#include "wthor.hpp"
+#include "zobrist.hpp"
+
+namespace reviser::ai {
+
+// A hash that is the same for all eight symmetric variants of a position: the
+// minimum of their Zobrist hashes. `symmetry` maps the position to the variant with
+// the minimal hash.
+struct CanonicalHash
+{
+    ZobristHash hash{};
+    Symmetry symmetry{Symmetry::identity};
+};
+
+[[nodiscard]] CanonicalHash
+compute_canonical_hash(Bits dark_bits, Bits light_bits, PlayerColor side_to_move);
+
+struct BookMove
+{
+    Position move;
+    // Average final disc difference for the player to move.
+    int score{};
+    std::uint32_t count{};
+};
+
+// Opening books are files with a 16-byte header ("RVBK", version, number of entries)
+// followed by 16-byte entries sorted by canonical hash: the hash, the move in the
+// canonical orientation, a reserved byte, the score (16 bits) and the count (32 bits),
+// all little endian. An `OpeningBook` searches the entries in place, so opening a
+// book costs a memory mapping and no parsing.
+inline constexpr std::string_view opening_book_magic{"RVBK"};
+inline constexpr std::uint32_t opening_book_version{1};
+inline constexpr std::size_t opening_book_header_size{16};
+inline constexpr std::size_t opening_book_entry_size{16};
+
+// Throws `std::invalid_argument` if the data is not an opening book.
+class OpeningBook
+{
+public:
+    explicit OpeningBook(const std::filesystem::path& path);
+    // The data must outlive the book.
+    explicit OpeningBook(std::span<const std::uint8_t> data);
+
+    [[nodiscard]] std::size_t size() const noexcept { return num_entries; }
+
+    [[nodiscard]] std::optional<BookMove>
+    find_move(Bits dark_bits, Bits light_bits, PlayerColor pc) const;
+
+    [[nodiscard]] std::optional<BookMove>
+    find_move(const BasicBoard& board, PlayerColor pc) const;
+
+private:
+    std::optional<MappedFile> mapped_file{};
+    std::span<const std::uint8_t> data{};
+    std::size_t num_entries{};
+
+    void validate();
+};
+
+// Collects moves from games or search results and writes them as an opening book.
+// For each position the book contains the move with the best average score among
+// the moves that were played at least half as often as the most frequent one.
+class OpeningBookBuilder
+{
+public:
+    void add_move(
+        Bits dark_bits,
+        Bits light_bits,
+        PlayerColor pc,
+        Position move,
+        int score,
+        std::uint32_t count = 1);
+
+    // Adds the move of the player with color `pc` on `board`.
+    void add_move(
+        const BitBoard& board,
+        PlayerColor pc,
+        Position move,
+        int score,
+        std::uint32_t count = 1);
+
+    // Adds the first `max_num_moves` moves of a game, scored with the final disc
+    // difference. Games that were lost by an invalid move are ignored.
+    void add_game(const GameRecord& record, std::size_t max_num_moves);
+    void add_game(const WthorGame& game, std::size_t max_num_moves);
+
+    [[nodiscard]] std::size_t get_num_positions() const;
+
+    void write(std::ostream& out) const;
+    void write(const std::filesystem::path& path) const;
+
+private:
+    struct MoveStatistics
+    {
+        std::int64_t total_score{};
+        std::uint32_t count{};
+    };
+
+    // Moves are stored in the canonical orientation of their position.
+    std::map<std::pair<ZobristHash, std::uint8_t>, MoveStatistics> moves{};
+};
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_OPENING_BOOK_HPP
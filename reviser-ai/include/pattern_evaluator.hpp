@@ -0,0 +1,307 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_PATTERN_EVALUATOR_HPP
+#define REVISER_AI_PATTERN_EVALUATOR_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "position.hpp"
+#include "position_set.hpp"
+#include "symmetry.hpp"
+
+namespace reviser::ai {
+
+// A pattern is a list of up to ten fields whose contents are combined into a base-3
+// index: the i-th field contributes its digit times 3^i, with 0 for an empty field, 1
+// for a disc of the player to move and 2 for a disc of the opponent. All instances
+// of a pattern are images of its fields under some of the board symmetries and share
+// one table of weights. Fields are given by their linear index.
+struct PatternType
+{
+    std::size_t num_fields{};
+    std::array<std::uint8_t, 10> fields{};
+    std::size_t num_symmetries{};
+    std::array<Symmetry, 8> symmetries{};
+
+    [[nodiscard]] constexpr std::size_t get_num_configurations() const
+    {
+        auto result = std::size_t{1};
+        for (std::size_t i = 0; i < num_fields; ++i) {
+            result *= 3;
+        }
+        return result;
+    }
+};
+
+namespace pattern_detail {
+
+constexpr std::array<Symmetry, 8> rotations{
+    Symmetry::identity, Symmetry::rotate_90, Symmetry::rotate_180, Symmetry::rotate_270};
+
+constexpr std::uint8_t field(const int row, const int column)
+{
+    return static_cast<std::uint8_t>(row * 8 + column);
+}
+
+constexpr PatternType make_row(const int row)
+{
+    auto result = PatternType{8, {}, 4, rotations};
+    for (auto i = 0; i < 8; ++i) {
+        result.fields[i] = field(row, i);
+    }
+    return result;
+}
+
+// The main diagonal is mapped onto itself by a rotation of 180 degrees, therefore it
+// has only two instances.
+constexpr PatternType make_diagonal(const int length)
+{
+    auto result = PatternType{
+        static_cast<std::size_t>(length), {}, length == 8 ? 2u : 4u, rotations};
+    for (auto i = 0; i < length; ++i) {
+        result.fields[i] = field(i, i + 8 - length);
+    }
+    return result;
+}
+
+} // namespace pattern_detail
+
+// The patterns of Logistello: edges with the two X-squares, 3x3 and 2x5 corners, all
+// diagonals with at least four fields and the second to fourth rows and columns.
+inline constexpr std::array<PatternType, 11> pattern_types{[] {
+    using namespace pattern_detail;
+    auto edge_2x = make_row(0);
+    edge_2x.num_fields = 10;
+    edge_2x.fields[8] = field(1, 1);
+    edge_2x.fields[9] = field(1, 6);
+
+    auto corner_3x3 = PatternType{9, {}, 4, rotations};
+    auto corner_2x5 = PatternType{10, {}, 8, all_symmetries};
+    for (auto i = 0; i < 10; ++i) {
+        if (i < 9) {
+            corner_3x3.fields[i] = field(i / 3, i % 3);
+        }
+        corner_2x5.fields[i] = field(i / 5, i % 5);
+    }
+
+    return std::array<PatternType, 11>{
+        edge_2x,
+        corner_3x3,
+        corner_2x5,
+        make_diagonal(8),
+        make_diagonal(7),
+        make_diagonal(6),
+        make_diagonal(5),
+        make_diagonal(4),
+        make_row(1),
+        make_row(2),
+        make_row(3),
+    };
+}()};
+
+inline constexpr std::size_t num_pattern_instances{[] {
+    auto result = std::size_t{0};
+    for (const auto& type : pattern_types) {
+        result += type.num_symmetries;
+    }
+    return result;
+}()};
+
+inline constexpr std::size_t num_weights_per_phase{[] {
+    auto result = std::size_t{0};
+    for (const auto& type : pattern_types) {
+        result += type.get_num_configurations();
+    }
+    return result;
+}()};
+
+struct PatternInstance
+{
+    std::size_t type{};
+    // Offset of the weights of the pattern type within the weights of a phase.
+    std::size_t weight_offset{};
+    std::size_t num_fields{};
+    std::array<std::uint8_t, 10> fields{};
+};
+
+inline constexpr std::array<PatternInstance, num_pattern_instances> pattern_instances{[] {
+    auto result = std::array<PatternInstance, num_pattern_instances>{};
+    auto instance_index = std::size_t{0};
+    auto weight_offset = std::size_t{0};
+    for (std::size_t type_index = 0; type_index < pattern_types.size(); ++type_index) {
+        const auto& type = pattern_types[type_index];
+        for (std::size_t s = 0; s < type.num_symmetries; ++s) {
+            auto& instance = result[instance_index++];
+            instance.type = type_index;
+            instance.weight_offset = weight_offset;
+            instance.num_fields = type.num_fields;
+            for (std::size_t i = 0; i < type.num_fields; ++i) {
+                instance.fields[i] = static_cast<std::uint8_t>(
+                    transform_position(
+                        Position::from_linear_index(type.fields[i]), type.symmetries[s])
+                        .to_linear_index());
+            }
+        }
+        weight_offset += type.get_num_configurations();
+    }
+    return result;
+}()};
+
+// The pattern instances that contain a field, with the power of 3 of the field.
+struct FieldPatterns
+{
+    struct Entry
+    {
+        std::uint8_t instance{};
+        std::uint16_t power{};
+    };
+
+    std::size_t size{};
+    std::array<Entry, 16> entries{};
+};
+
+inline constexpr std::array<FieldPatterns, 64> field_patterns{[] {
+    auto result = std::array<FieldPatterns, 64>{};
+    for (std::size_t i = 0; i < num_pattern_instances; ++i) {
+        auto power = std::uint16_t{1};
+        for (std::size_t j = 0; j < pattern_instances[i].num_fields; ++j) {
+            auto& patterns = result[pattern_instances[i].fields[j]];
+            patterns.entries.at(patterns.size++) = {static_cast<std::uint8_t>(i), power};
+            power *= 3;
+        }
+    }
+    return result;
+}()};
+
+// The base-3 indices of all pattern instances for both players.
+struct PatternIndices
+{
+    std::array<std::array<std::uint16_t, num_pattern_instances>, 2> indices{};
+
+    [[nodiscard]] const std::array<std::uint16_t, num_pattern_instances>&
+    for_player(const PlayerColor pc) const
+    {
+        return indices[static_cast<std::size_t>(pc)];
+    }
+};
+
+[[nodiscard]] PatternIndices compute_pattern_indices(Bits dark_bits, Bits light_bits);
+
+// Weight files start with the magic bytes, the version, the number of phases and the
+// number of weights per phase as 32-bit little-endian values; the weights follow as
+// 16-bit little-endian values, phase by phase.
+inline constexpr std::string_view pattern_weights_magic{"RVPW"};
+inline constexpr std::uint32_t pattern_weights_version{1};
+
+// Weight tables for all patterns, one set for each game phase. The phases divide the
+// number of discs on the board into equally sized ranges.
+class PatternWeights
+{
+public:
+    explicit PatternWeights(std::size_t num_phases = 1);
+
+    // Weights that reproduce the static field values of `evaluate_position()`.
+    [[nodiscard]] static std::shared_ptr<const PatternWeights> get_default();
+
+    // Reads weights written by `save()`. Throws `std::invalid_argument` if the file
+    // cannot be read or does not contain pattern weights.
+    [[nodiscard]] static PatternWeights load(const std::filesystem::path& path);
+    void save(const std::filesystem::path& path) const;
+
+    [[nodiscard]] std::size_t get_num_phases() const noexcept { return num_phases; }
+
+    [[nodiscard]] std::size_t get_phase(const int num_discs) const noexcept
+    {
+        return static_cast<std::size_t>(num_discs - 4) * num_phases / 61;
+    }
+
+    [[nodiscard]] std::span<const std::int16_t> get_weights(const std::size_t phase) const
+    {
+        return std::span{weights}.subspan(phase * num_weights_per_phase, num_weights_per_phase);
+    }
+
+    [[nodiscard]] std::span<std::int16_t> get_weights(const std::size_t phase)
+    {
+        return std::span{weights}.subspan(phase * num_weights_per_phase, num_weights_per_phase);
+    }
+
+    [[nodiscard]] int evaluate(const PatternIndices& indices, PlayerColor pc, int num_discs) const
+    {
+        const auto phase_weights = get_weights(get_phase(num_discs));
+        const auto& player_indices = indices.for_player(pc);
+        auto result = 0;
+        for (std::size_t i = 0; i < num_pattern_instances; ++i) {
+            result += phase_weights[pattern_instances[i].weight_offset + player_indices[i]];
+        }
+        return result;
+    }
+
+private:
+    std::size_t num_phases;
+    std::vector<std::int16_t> weights;
+};
+
+// Logistello-style evaluation by pattern weights. The pattern indices are updated
+// from the flipped fields of each move, so that an evaluation costs one table lookup
+// per pattern instance.
+class PatternEvaluator
+{
+public:
+    PatternEvaluator()
+        : PatternEvaluator{PatternWeights::get_default()}
+    {}
+
+    explicit PatternEvaluator(std::shared_ptr<const PatternWeights> weights);
+
+    template <BasicBoardType BoardT>
+    void set_board(const BoardT& board)
+    {
+        auto dark_bits = Bits{};
+        auto light_bits = Bits{};
+        for (const auto pos : all_board_positions()) {
+            if (const Field field = board[pos]; field == Field::dark) {
+                dark_bits |= position_bit(pos);
+            }
+            else if (field == Field::light) {
+                light_bits |= position_bit(pos);
+            }
+        }
+        indices = compute_pattern_indices(dark_bits, light_bits);
+        num_discs = std::popcount(dark_bits | light_bits);
+    }
+
+    void play_move(const FlipRecord& record);
+    void undo_move(const FlipRecord& record);
+
+    template <BasicBoardType BoardT>
+    [[nodiscard]] int evaluate(const BoardT& board, const PlayerColor pc) const
+    {
+        return weights->evaluate(indices, pc, num_discs);
+    }
+
+    [[nodiscard]] const PatternIndices& get_indices() const noexcept { return indices; }
+
+    [[nodiscard]] int get_num_discs() const noexcept { return num_discs; }
+
+private:
+    std::shared_ptr<const PatternWeights> weights;
+    PatternIndices indices{};
+    int num_discs{};
+
+    void update_indices(const FlipRecord& record, int direction);
+};
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_PATTERN_EVALUATOR_HPP
@@ -0,0 +1,86 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_PATTERN_TRAINING_HPP
+#define REVISER_AI_PATTERN_TRAINING_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "game_record.hpp"
+#include "pattern_evaluator.hpp"
+#include "wthor.hpp"
+
+namespace reviser::ai {
+
+// Trained weights predict the final disc difference in hundredths of a disc.
+inline constexpr int pattern_score_scale{100};
+
+// A position of a finished game, described by its pattern indices from the point of
+// view of the player to move, labelled with the final disc difference for that player.
+struct TrainingPosition
+{
+    std::array<std::uint16_t, num_pattern_instances> indices{};
+    std::int8_t num_discs{};
+    std::int8_t disc_difference{};
+};
+
+// The positions of a collection of games. The pattern indices are updated
+// incrementally while the games are replayed.
+class TrainingSet
+{
+public:
+    // Adds the positions before each move of the game and returns their number.
+    // Games lost by an invalid move are skipped. Throws `std::invalid_argument` if the
+    // game contains an invalid move.
+    std::size_t add_game(const GameRecord& record);
+    std::size_t add_game(const WthorGame& game);
+
+    [[nodiscard]] const std::vector<TrainingPosition>& get_positions() const noexcept
+    {
+        return positions;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return positions.size(); }
+
+    void reserve(const std::size_t num_positions) { positions.reserve(num_positions); }
+
+private:
+    std::vector<TrainingPosition> positions{};
+    PatternEvaluator evaluator{};
+
+    void add_position(PlayerColor pc, int final_dark_disc_difference);
+};
+
+struct TrainingConfig
+{
+    std::size_t num_phases{12};
+    std::size_t num_epochs{100};
+    // The fraction of the mean error of the positions that contain a configuration by
+    // which its weight is moved in each epoch, divided by the number of patterns.
+    double learning_rate{1.0};
+    std::size_t num_threads{std::max(std::thread::hardware_concurrency(), 1u)};
+};
+
+// Called after each epoch with the number of the epoch, starting at 1, and the mean
+// squared error of the predictions in discs before the update.
+using TrainingProgress = std::function<void(std::size_t epoch, double mean_squared_error)>;
+
+// Fits pattern weights to the positions by least squares. Every epoch computes the
+// errors of all predictions on `config.num_threads` threads and moves each weight by
+// the mean error of the positions that use it, which converges much faster than
+// plain gradient descent for the very unevenly used configurations. Throws
+// `std::invalid_argument` if the training set is empty.
+[[nodiscard]] PatternWeights train_pattern_weights(
+    const TrainingSet& training_set,
+    const TrainingConfig& config,
+    const TrainingProgress& progress = {});
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_PATTERN_TRAINING_HPP
@@ -0,0 +1,97 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_PROBCUT_HPP
+#define REVISER_AI_PROBCUT_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace reviser::ai {
+
+// Linear model of the value of a deep search by the value of a shallow search of the
+// same position: deep = slope * shallow + intercept, with residuals of standard
+// deviation `sigma`.
+struct ProbCutRegression
+{
+    double slope{};
+    double intercept{};
+    double sigma{};
+
+    // Regressions without enough data to fit them have a slope of zero.
+    [[nodiscard]] bool is_valid() const noexcept { return slope > 0.0 && sigma > 0.0; }
+};
+
+// Parameters of Multi-ProbCut: one regression for each game stage and each search
+// depth from `min_depth` to the maximum depth. A node of depth `d` is cut off if a
+// search of depth `get_shallow_depth(d)` predicts a fail high or fail low with
+// `cut_threshold` standard deviations to spare. The stages divide the number of
+// discs on the board into equally sized ranges, like the phases of `PatternWeights`.
+class ProbCutParameters
+{
+public:
+    static constexpr int min_depth{3};
+    static constexpr double default_cut_threshold{1.5};
+
+    // All regressions are invalid until they are set.
+    explicit ProbCutParameters(std::size_t num_stages = 1, int max_depth = 10);
+
+    // Parameters for the default pattern weights, for four stages and depths up to 10.
+    [[nodiscard]] static std::shared_ptr<const ProbCutParameters> get_default();
+
+    // Reads parameters written by `save()`. Throws `std::invalid_argument` if the
+    // file cannot be read or does not contain ProbCut parameters.
+    [[nodiscard]] static ProbCutParameters load(const std::filesystem::path& path);
+    void save(const std::filesystem::path& path) const;
+
+    [[nodiscard]] std::size_t get_num_stages() const noexcept { return num_stages; }
+    [[nodiscard]] int get_max_depth() const noexcept { return max_depth; }
+
+    [[nodiscard]] std::size_t get_stage(const int num_discs) const noexcept
+    {
+        return static_cast<std::size_t>(num_discs - 4) * num_stages / 61;
+    }
+
+    // The depth of the search that predicts a search of `depth` plies. It has the
+    // same parity as `depth`, since evaluations differ systematically between the
+    // two players.
+    [[nodiscard]] static int get_shallow_depth(int depth) noexcept;
+
+    [[nodiscard]] const ProbCutRegression& get_regression(std::size_t stage, int depth) const;
+    void set_regression(std::size_t stage, int depth, const ProbCutRegression& regression);
+
+    [[nodiscard]] double get_cut_threshold() const noexcept { return cut_threshold; }
+    void set_cut_threshold(double threshold);
+
+private:
+    std::size_t num_stages;
+    int max_depth;
+    double cut_threshold{default_cut_threshold};
+    std::vector<ProbCutRegression> regressions;
+
+    [[nodiscard]] std::size_t index_of(std::size_t stage, int depth) const;
+};
+
+// The values of searches of depth 0 to `values.size() - 1` of one position, from the
+// point of view of the player to move.
+struct ProbCutSample
+{
+    int num_discs{};
+    std::vector<int> values{};
+};
+
+// Fits the regressions for all stages and depths up to `max_depth` by least squares.
+// Pairs of values that include the score of a finished game are ignored. Regressions
+// with fewer than `min_samples` samples remain invalid.
+[[nodiscard]] ProbCutParameters fit_probcut_parameters(
+    std::span<const ProbCutSample> samples,
+    std::size_t num_stages,
+    int max_depth,
+    std::size_t min_samples = 16);
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_PROBCUT_HPP
@@ -1,26 +1,43 @@
-// Copyright (c) 2022-2023 Dr. Matthias Hölzl.
+// Copyright (c) 2022-2024 Dr. Matthias Hölzl.
 
 #pragma once
 #ifndef RANDOM_PLAYER_HPP
 #define RANDOM_PLAYER_HPP
 
-#include <random>
+#include <cstdint>
+#include <string_view>
 
 #include "board.hpp"
 #include "player.hpp"
+#include "random.hpp"
 
 namespace reviser::ai {
 
     class RandomPlayer final : public Player {
     public:
-        using Player::Player;
+        // Seeds the generator from `std::random_device`.
+        explicit RandomPlayer(
+                std::string_view name = "Random player",
+                PlayerColor pc = PlayerColor::dark);
+
+        // Plays the same sequence of moves for each run with the same seed.
+        RandomPlayer(std::string_view name, std::uint64_t seed, PlayerColor pc = PlayerColor::dark)
+                : Player{name, pc}, rng{seed} {}
 
         [[nodiscard]] Position pick_move(const BasicBoard &board) const override;
 
+        // Statically dispatched version of `pick_move()` for concrete board types.
+        template<BoardType BoardT>
+        [[nodiscard]] Position pick_move(const BoardT &board) const {
+            return pick_move_from(board.find_valid_moves(get_color()));
+        }
+
     private:
-        static std::mt19937 make_rng() { return std::mt19937{std::random_device{}()}; }
+        mutable Xoshiro256 rng;
+
+        [[nodiscard]] Position pick_move_from(PositionSet moves) const;
     };
 
 } // namespace reviser::ai
 
-#endif // RANDOM_PLAYER_HPP
\ No newline at end of file
+#endif // RANDOM_PLAYER_HPP
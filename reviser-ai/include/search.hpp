@@ -0,0 +1,420 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_SEARCH_HPP
+#define REVISER_AI_SEARCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "evaluation.hpp"
+#include "position.hpp"
+#include "position_set.hpp"
+#include "probcut.hpp"
+#include "transposition_table.hpp"
+
+namespace reviser::ai {
+
+struct SearchLimits
+{
+    int max_depth{8};
+    std::uint64_t max_nodes{std::numeric_limits<std::uint64_t>::max()};
+    std::chrono::milliseconds max_time{std::chrono::milliseconds::max()};
+};
+
+struct SearchStatistics
+{
+    std::uint64_t nodes{};
+    std::chrono::nanoseconds elapsed_time{};
+    int completed_depth{};
+
+    [[nodiscard]] double get_nodes_per_second() const;
+    [[nodiscard]] std::string to_string() const;
+
+    SearchStatistics& operator+=(const SearchStatistics& other);
+};
+
+// Totals of the searches of a player, e.g., over all games of a match.
+struct SearchTotals
+{
+    std::uint64_t num_searches{};
+    std::uint64_t nodes{};
+    std::uint64_t total_depth{};
+    std::chrono::nanoseconds elapsed_time{};
+
+    [[nodiscard]] double get_average_depth() const;
+    [[nodiscard]] double get_average_nodes() const;
+    [[nodiscard]] std::string to_string() const;
+
+    void add(const SearchStatistics& statistics);
+
+    SearchTotals& operator+=(const SearchTotals& other);
+};
+
+// Implemented by players that search, so that their totals can be reported without
+// knowing their types.
+class SearchTotalsSource
+{
+public:
+    virtual ~SearchTotalsSource() = default;
+
+    [[nodiscard]] virtual SearchTotals get_search_totals() const = 0;
+};
+
+struct SearchResult
+{
+    std::optional<Position> best_move{};
+    int score{};
+    SearchStatistics statistics{};
+};
+
+// The moves of a position, sorted so that the most promising moves come first.
+class OrderedMoves
+{
+public:
+    explicit OrderedMoves(
+        const PositionSet moves, const std::optional<Position> first_move = {})
+    {
+        for (const auto move : moves) {
+            indices[size++] = static_cast<std::uint8_t>(move.to_linear_index());
+        }
+        std::sort(indices.begin(), indices.begin() + size, [&](auto lhs, auto rhs) {
+            return rank(lhs, first_move) > rank(rhs, first_move);
+        });
+    }
+
+    [[nodiscard]] auto begin() const { return indices.begin(); }
+    [[nodiscard]] auto end() const { return indices.begin() + size; }
+
+private:
+    std::array<std::uint8_t, 64> indices{};
+    std::size_t size{};
+
+    static int rank(const std::uint8_t index, const std::optional<Position> first_move)
+    {
+        if (first_move && first_move->to_linear_index() == index) {
+            return std::numeric_limits<int>::max();
+        }
+        return field_values[index];
+    }
+};
+
+// Settings that let the threads of a parallel search differ from each other. The
+// defaults give a single-threaded search.
+struct SearchThreadSettings
+{
+    // Added to the depth of every iteration of the iterative deepening.
+    int depth_offset{};
+    // The root moves after the first one are rotated by this amount.
+    std::size_t root_move_rotation{};
+    // The search stops when this flag is set.
+    const std::atomic<bool>* stop_flag{};
+    // Whether `search()` starts a new search of the transposition table. Parallel
+    // searches start it once for all threads.
+    bool starts_new_table_search{true};
+};
+
+// Negamax search with alpha-beta pruning and iterative deepening. The board is
+// modified in place with `play_move()` and `undo_move()`, and leaves are evaluated by
+// `EvaluatorT`. If a transposition table is set, it is used for cutoffs and move
+// ordering; it may be shared with other searches, also running in other threads.
+// If ProbCut parameters are set, the search is selective: nodes whose value a
+// shallow search predicts to lie outside the window with high probability are cut
+// off (Multi-ProbCut). The parameters must be fitted for `EvaluatorT`.
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT = FieldValueEvaluator>
+class AlphaBetaSearch
+{
+public:
+    explicit AlphaBetaSearch(
+        const SearchLimits limits = {},
+        std::shared_ptr<TranspositionTable> transposition_table = {},
+        EvaluatorT evaluator = {})
+        : limits{limits}
+        , transposition_table{std::move(transposition_table)}
+        , evaluator{std::move(evaluator)}
+    {}
+
+    [[nodiscard]] const SearchLimits& get_limits() const { return limits; }
+    void set_limits(const SearchLimits new_limits) { limits = new_limits; }
+
+    [[nodiscard]] const std::shared_ptr<TranspositionTable>&
+    get_transposition_table() const
+    {
+        return transposition_table;
+    }
+    void set_transposition_table(std::shared_ptr<TranspositionTable> table)
+    {
+        transposition_table = std::move(table);
+    }
+
+    [[nodiscard]] const std::shared_ptr<const ProbCutParameters>& get_probcut_parameters() const
+    {
+        return probcut_parameters;
+    }
+    void set_probcut_parameters(std::shared_ptr<const ProbCutParameters> parameters)
+    {
+        probcut_parameters = std::move(parameters);
+    }
+
+    [[nodiscard]] const SearchThreadSettings& get_thread_settings() const
+    {
+        return thread_settings;
+    }
+    void set_thread_settings(const SearchThreadSettings& settings) { thread_settings = settings; }
+
+    [[nodiscard]] SearchResult search(const BoardT& initial_board, PlayerColor pc);
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int infinity{std::numeric_limits<int>::max() / 2};
+    static constexpr std::uint64_t nodes_between_time_checks{4096};
+
+    SearchLimits limits;
+    std::shared_ptr<TranspositionTable> transposition_table;
+    EvaluatorT evaluator;
+    std::shared_ptr<const ProbCutParameters> probcut_parameters{};
+    SearchThreadSettings thread_settings{};
+    BoardT board{};
+    std::uint64_t nodes{};
+    Clock::time_point start_time{};
+    bool is_stopped{};
+
+    [[nodiscard]] int
+    search_root(PlayerColor pc, int depth, std::optional<Position>& best_move);
+
+    [[nodiscard]] int
+    negamax(PlayerColor pc, int depth, int alpha, int beta, bool opponent_passed);
+
+    [[nodiscard]] std::optional<int> try_probcut(PlayerColor pc, int depth, int alpha, int beta);
+
+    [[nodiscard]] bool should_stop();
+};
+
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT>
+SearchResult
+AlphaBetaSearch<BoardT, EvaluatorT>::search(const BoardT& initial_board, const PlayerColor pc)
+{
+    board = initial_board;
+    evaluator.set_board(board);
+    nodes = 0;
+    is_stopped = false;
+    start_time = Clock::now();
+    if (transposition_table && thread_settings.starts_new_table_search) {
+        transposition_table->new_search();
+    }
+
+    auto result = SearchResult{};
+    if (const auto moves = board.find_valid_moves(pc); !moves.empty()) {
+        result.best_move = *moves.begin();
+        const int num_empty_fields = board.compute_score().get_num_empty_fields();
+        for (auto iteration = 1; iteration <= limits.max_depth; ++iteration) {
+            const auto depth = iteration + thread_settings.depth_offset;
+            auto best_move = result.best_move;
+            const auto score = search_root(pc, depth, best_move);
+            if (is_stopped) {
+                break;
+            }
+            result.best_move = best_move;
+            result.score = score;
+            result.statistics.completed_depth = depth;
+            if (depth >= num_empty_fields) {
+                break;
+            }
+        }
+    }
+    result.statistics.nodes = nodes;
+    result.statistics.elapsed_time = Clock::now() - start_time;
+    return result;
+}
+
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT>
+int AlphaBetaSearch<BoardT, EvaluatorT>::search_root(
+    const PlayerColor pc, const int depth, std::optional<Position>& best_move)
+{
+    ++nodes;
+    auto moves = std::array<std::uint8_t, 64>{};
+    auto num_moves = std::size_t{0};
+    for (const auto index : OrderedMoves{board.find_valid_moves(pc), best_move}) {
+        moves[num_moves++] = index;
+    }
+    if (num_moves > 2) {
+        const auto rotation = thread_settings.root_move_rotation % (num_moves - 1);
+        std::rotate(moves.begin() + 1, moves.begin() + 1 + rotation, moves.begin() + num_moves);
+    }
+
+    auto alpha = -infinity;
+    for (const auto index : std::span{moves}.first(num_moves)) {
+        const auto move = Position::from_linear_index(index);
+        const auto record = board.play_move(pc, move);
+        evaluator.play_move(record);
+        const auto score = -negamax(other_player_color(pc), depth - 1, -infinity, -alpha, false);
+        evaluator.undo_move(record);
+        board.undo_move(record);
+        if (is_stopped) {
+            break;
+        }
+        if (score > alpha) {
+            alpha = score;
+            best_move = move;
+        }
+    }
+    if (transposition_table && !is_stopped) {
+        transposition_table->store(board.get_hash(pc), {alpha, depth, Bound::exact, best_move});
+    }
+    return alpha;
+}
+
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT>
+int AlphaBetaSearch<BoardT, EvaluatorT>::negamax(
+    const PlayerColor pc, const int depth, int alpha, int beta, const bool opponent_passed)
+{
+    ++nodes;
+    if (should_stop()) {
+        return 0;
+    }
+    const auto moves = board.find_valid_moves(pc);
+    if (moves.empty()) {
+        if (opponent_passed) {
+            return terminal_score(board.compute_score(), pc);
+        }
+        return -negamax(other_player_color(pc), depth, -beta, -alpha, true);
+    }
+    if (depth <= 0) {
+        return evaluator.evaluate(board, pc);
+    }
+
+    const auto hash = transposition_table ? board.get_hash(pc) : ZobristHash{};
+    auto table_move = std::optional<Position>{};
+    if (transposition_table) {
+        if (const auto entry = transposition_table->probe(hash)) {
+            table_move = entry->best_move;
+            if (entry->depth >= depth) {
+                switch (entry->bound) {
+                case Bound::exact: return entry->score;
+                case Bound::lower: alpha = std::max(alpha, entry->score); break;
+                case Bound::upper: beta = std::min(beta, entry->score); break;
+                }
+                if (alpha >= beta) {
+                    return entry->score;
+                }
+            }
+        }
+    }
+
+    if (probcut_parameters && depth >= ProbCutParameters::min_depth
+        && depth <= probcut_parameters->get_max_depth()) {
+        if (const auto score = try_probcut(pc, depth, alpha, beta)) {
+            return *score;
+        }
+    }
+
+    const auto original_alpha = alpha;
+    auto best_score = -infinity;
+    auto best_move = std::optional<Position>{};
+    for (const auto index : OrderedMoves{moves, table_move}) {
+        const auto move = Position::from_linear_index(index);
+        const auto record = board.play_move(pc, move);
+        evaluator.play_move(record);
+        const auto score = -negamax(other_player_color(pc), depth - 1, -beta, -alpha, false);
+        evaluator.undo_move(record);
+        board.undo_move(record);
+        if (is_stopped) {
+            return 0;
+        }
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+        }
+        alpha = std::max(alpha, score);
+        if (alpha >= beta) {
+            break;
+        }
+    }
+
+    if (transposition_table) {
+        const auto bound = best_score <= original_alpha ? Bound::upper
+                           : best_score >= beta         ? Bound::lower
+                                                        : Bound::exact;
+        transposition_table->store(hash, {best_score, depth, bound, best_move});
+    }
+    return best_score;
+}
+
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT>
+std::optional<int> AlphaBetaSearch<BoardT, EvaluatorT>::try_probcut(
+    const PlayerColor pc, const int depth, const int alpha, const int beta)
+{
+    const auto num_discs = 64 - board.compute_score().get_num_empty_fields();
+    const auto& regression
+        = probcut_parameters->get_regression(probcut_parameters->get_stage(num_discs), depth);
+    if (!regression.is_valid()) {
+        return std::nullopt;
+    }
+    const auto shallow_depth = ProbCutParameters::get_shallow_depth(depth);
+    const auto margin = probcut_parameters->get_cut_threshold() * regression.sigma;
+
+    // The deep search probably fails high if the shallow search reaches the value
+    // that predicts `beta` plus the margin, and fails low if it stays below the value
+    // that predicts `alpha` minus the margin. Both checks use null windows.
+    if (beta < infinity) {
+        // Compared as doubles, since large thresholds put the bounds beyond `int`.
+        const auto bound = std::ceil((beta + margin - regression.intercept) / regression.slope);
+        if (bound < infinity) {
+            const auto shallow_beta = static_cast<int>(bound);
+            if (negamax(pc, shallow_depth, shallow_beta - 1, shallow_beta, false)
+                >= shallow_beta) {
+                return beta;
+            }
+        }
+    }
+    if (alpha > -infinity && !is_stopped) {
+        const auto bound = std::floor((alpha - margin - regression.intercept) / regression.slope);
+        if (bound > -infinity) {
+            const auto shallow_alpha = static_cast<int>(bound);
+            if (negamax(pc, shallow_depth, shallow_alpha, shallow_alpha + 1, false)
+                <= shallow_alpha) {
+                return alpha;
+            }
+        }
+    }
+    if (is_stopped) {
+        return 0;
+    }
+    return std::nullopt;
+}
+
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT>
+bool AlphaBetaSearch<BoardT, EvaluatorT>::should_stop()
+{
+    if (!is_stopped) {
+        if (nodes >= limits.max_nodes
+            || (thread_settings.stop_flag
+                && thread_settings.stop_flag->load(std::memory_order_relaxed))) {
+            is_stopped = true;
+        }
+        else if (
+            limits.max_time != std::chrono::milliseconds::max()
+            && nodes % nodes_between_time_checks == 0
+            && Clock::now() - start_time >= limits.max_time) {
+            is_stopped = true;
+        }
+    }
+    return is_stopped;
+}
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_SEARCH_HPP
@@ -0,0 +1,106 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_SEARCH_PLAYER_HPP
+#define REVISER_AI_SEARCH_PLAYER_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "board.hpp"
+#include "evaluation.hpp"
+#include "player.hpp"
+#include "probcut.hpp"
+#include "search.hpp"
+
+namespace reviser::ai {
+
+// A computer player that picks its moves with `AlphaBetaSearch` on a copy of the
+// board converted to `BoardT`. Several players may share a transposition table.
+template <BoardType BoardT, EvaluatorFor<BoardT> EvaluatorT = FieldValueEvaluator>
+class SearchPlayer final
+    : public Player
+    , public SearchTotalsSource
+{
+public:
+    explicit SearchPlayer(
+        const std::string_view name = "Search player",
+        const SearchLimits limits = {},
+        const PlayerColor pc = PlayerColor::dark,
+        std::shared_ptr<TranspositionTable> transposition_table = {},
+        EvaluatorT evaluator = {})
+        : Player{name, pc}
+        , search{limits, std::move(transposition_table), std::move(evaluator)}
+    {}
+
+    void new_game() override { total_statistics = {}; }
+
+    [[nodiscard]] Position pick_move(const BasicBoard& board) const override
+    {
+        return pick_move(copy_board_as<BoardT>(board));
+    }
+
+    // Statically dispatched version of `pick_move()` that searches `board` without
+    // converting it.
+    [[nodiscard]] Position pick_move(const BoardT& board) const
+    {
+        const auto result = search.search(board, get_color());
+        if (!result.best_move) {
+            throw std::invalid_argument("Search player has no valid move.");
+        }
+        last_statistics = result.statistics;
+        total_statistics += result.statistics;
+        search_totals.add(result.statistics);
+        return *result.best_move;
+    }
+
+    [[nodiscard]] const SearchLimits& get_limits() const { return search.get_limits(); }
+    void set_limits(const SearchLimits limits) { search.set_limits(limits); }
+
+    [[nodiscard]] const std::shared_ptr<TranspositionTable>&
+    get_transposition_table() const
+    {
+        return search.get_transposition_table();
+    }
+    void set_transposition_table(std::shared_ptr<TranspositionTable> table)
+    {
+        search.set_transposition_table(std::move(table));
+    }
+
+    // With ProbCut parameters, the player searches selectively.
+    [[nodiscard]] const std::shared_ptr<const ProbCutParameters>& get_probcut_parameters() const
+    {
+        return search.get_probcut_parameters();
+    }
+    void set_probcut_parameters(std::shared_ptr<const ProbCutParameters> parameters)
+    {
+        search.set_probcut_parameters(std::move(parameters));
+    }
+
+    // Statistics of the most recent call to `pick_move()`.
+    [[nodiscard]] const SearchStatistics& get_last_statistics() const
+    {
+        return last_statistics;
+    }
+
+    // Statistics accumulated over all moves since the start of the current game.
+    [[nodiscard]] const SearchStatistics& get_total_statistics() const
+    {
+        return total_statistics;
+    }
+
+    // Totals of all searches since the player was created.
+    [[nodiscard]] SearchTotals get_search_totals() const override { return search_totals; }
+
+private:
+    mutable AlphaBetaSearch<BoardT, EvaluatorT> search;
+    mutable SearchStatistics last_statistics{};
+    mutable SearchStatistics total_statistics{};
+    mutable SearchTotals search_totals{};
+};
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_SEARCH_PLAYER_HPP
@@ -0,0 +1,90 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_TRANSPOSITION_TABLE_HPP
+#define REVISER_AI_TRANSPOSITION_TABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "position.hpp"
+#include "zobrist.hpp"
+
+namespace reviser::ai {
+
+enum class Bound : std::uint8_t
+{
+    exact,
+    lower,
+    upper,
+};
+
+struct TranspositionEntry
+{
+    int score{};
+    int depth{};
+    Bound bound{Bound::exact};
+    std::optional<Position> best_move{};
+
+    friend bool operator==(const TranspositionEntry&, const TranspositionEntry&) = default;
+};
+
+// A fixed-size hash table for search results that can be shared between threads
+// without locks. Each slot stores the key XORed with the packed data, so that a
+// torn write by a concurrent `store()` is detected by `probe()` as a miss.
+class TranspositionTable
+{
+public:
+    static constexpr std::size_t default_size_in_mb{16};
+
+    explicit TranspositionTable(std::size_t size_in_mb = default_size_in_mb);
+
+    [[nodiscard]] std::optional<TranspositionEntry> probe(ZobristHash hash) const;
+
+    // Stores `entry`, replacing an entry for the same position, an empty slot, or
+    // the shallowest entry of the bucket, preferring entries of earlier searches.
+    void store(ZobristHash hash, const TranspositionEntry& entry);
+
+    // Marks all existing entries as belonging to an earlier search.
+    void new_search();
+
+    // Removes all entries. Must not be called while other threads use the table.
+    void clear();
+
+    [[nodiscard]] std::size_t get_num_entries() const;
+    [[nodiscard]] std::size_t get_size_in_bytes() const;
+
+private:
+    static constexpr std::size_t slots_per_bucket{4};
+
+    struct Slot
+    {
+        std::atomic<std::uint64_t> key_xor_data{};
+        std::atomic<std::uint64_t> data{};
+    };
+
+    struct alignas(64) Bucket
+    {
+        std::array<Slot, slots_per_bucket> slots{};
+    };
+
+    std::size_t num_buckets;
+    std::unique_ptr<Bucket[]> buckets;
+    std::atomic<std::uint8_t> generation{};
+
+    [[nodiscard]] Bucket& bucket_for(ZobristHash hash) const;
+
+    [[nodiscard]] static std::uint64_t
+    pack(const TranspositionEntry& entry, std::uint8_t generation);
+    [[nodiscard]] static TranspositionEntry unpack(std::uint64_t data);
+    [[nodiscard]] static int depth_of(std::uint64_t data);
+    [[nodiscard]] static std::uint8_t generation_of(std::uint64_t data);
+};
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_TRANSPOSITION_TABLE_HPP
@@ -0,0 +1,112 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_AI_WORK_STEALING_DEQUE_HPP
+#define REVISER_AI_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace reviser::ai {
+
+// A Chase-Lev work-stealing deque of pointers with a fixed capacity. Only the owning
+// thread may call `push()` and `pop()`, which work at the bottom of the deque; any
+// thread may call `steal()`, which takes the oldest element from the top. The
+// memory orderings follow Lê, Pop, Cohen and Zappa Nardelli, "Correct and Efficient
+// Work-Stealing for Weak Memory Models" (PPoPP 2013), with sequentially consistent
+// accesses in place of the fences.
+template <typename T>
+class WorkStealingDeque
+{
+public:
+    // `capacity` is rounded up to a power of two.
+    explicit WorkStealingDeque(const std::size_t capacity = 1024)
+        : mask{std::bit_ceil(capacity) - 1}
+        , elements{std::make_unique<std::atomic<T*>[]>(mask + 1)}
+    {
+        if (capacity == 0) {
+            throw std::invalid_argument("A deque needs a positive capacity.");
+        }
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    [[nodiscard]] std::size_t get_capacity() const { return mask + 1; }
+
+    // Returns false if the deque is full.
+    bool push(T* element)
+    {
+        const auto b = bottom.load(std::memory_order_relaxed);
+        const auto t = top.load(std::memory_order_acquire);
+        if (static_cast<std::size_t>(b - t) > mask) {
+            return false;
+        }
+        slot(b).store(element, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    // The most recently pushed element, or `nullptr` if the deque is empty.
+    [[nodiscard]] T* pop()
+    {
+        const auto b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_seq_cst);
+        auto t = top.load(std::memory_order_seq_cst);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        auto* element = slot(b).load(std::memory_order_relaxed);
+        if (t == b) {
+            // The last element: race against thieves for it.
+            if (!top.compare_exchange_strong(
+                    t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                element = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return element;
+    }
+
+    // The oldest element, or `nullptr` if the deque is empty or another thread took
+    // the element first.
+    [[nodiscard]] T* steal()
+    {
+        auto t = top.load(std::memory_order_seq_cst);
+        const auto b = bottom.load(std::memory_order_seq_cst);
+        if (t >= b) {
+            return nullptr;
+        }
+        auto* element = slot(t).load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(
+                t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return element;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return top.load(std::memory_order_relaxed) >= bottom.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::size_t mask;
+    std::unique_ptr<std::atomic<T*>[]> elements;
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+
+    std::atomic<T*>& slot(const std::int64_t index) const
+    {
+        return elements[static_cast<std::size_t>(index) & mask];
+    }
+};
+
+} // namespace reviser::ai
+
+#endif // REVISER_AI_WORK_STEALING_DEQUE_HPP
@@ -0,0 +1,43 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "book_player.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace reviser::ai {
+
+BookPlayer::BookPlayer(std::shared_ptr<Player> player, std::shared_ptr<const OpeningBook> book)
+    : player{std::move(player)}
+    , book{std::move(book)}
+{
+    // Make sure not to access the arguments in the body of the constructor, since
+    // we have moved from them!
+    if (this->player == nullptr || this->book == nullptr) {
+        throw std::invalid_argument("Must provide a valid player and opening book.");
+    }
+    set_name(this->player->get_name());
+    set_color(this->player->get_color());
+}
+
+void BookPlayer::new_game()
+{
+    num_book_moves = 0;
+    player->new_game();
+}
+
+Position BookPlayer::pick_move(const BasicBoard& board) const
+{
+    // Colors are assigned to the book player, not to the wrapped one.
+    player->set_color(get_color());
+    if (const auto book_move = book->find_move(board, get_color());
+        book_move && board.is_valid_move(get_color(), book_move->move)) {
+        ++num_book_moves;
+        return book_move->move;
+    }
+    return player->pick_move(board);
+}
+
+void BookPlayer::game_over(const GameResult& result) { player->game_over(result); }
+
+} // namespace reviser::ai
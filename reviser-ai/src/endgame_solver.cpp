@@ -0,0 +1,867 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "endgame_solver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "bit_board.hpp"
+#include "work_stealing_deque.hpp"
+
+namespace reviser::ai {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int max_disc_difference{64};
+// Below this number of empty fields, moves are ordered by parity only since
+// computing the opponent's mobility costs more than it saves.
+constexpr int min_empties_for_fastest_first{7};
+constexpr int min_empties_for_stability_cutoff{5};
+constexpr int min_empties_for_transposition_table{8};
+// Nodes with fewer empty fields are not worth sharing between threads.
+constexpr int min_empties_for_split{12};
+constexpr std::size_t split_deque_capacity{4096};
+
+constexpr Bits corner_bits{0x8100'0000'0000'0081ULL};
+constexpr Bits row_0_bits{0x0000'0000'0000'00ffULL};
+constexpr Bits row_7_bits{0xff00'0000'0000'0000ULL};
+constexpr Bits column_0_bits{~not_column_0_bits};
+constexpr Bits column_7_bits{~not_column_7_bits};
+constexpr Bits border_bits{row_0_bits | row_7_bits | column_0_bits | column_7_bits};
+constexpr std::array<Bits, 4> quadrant_bits{
+    0x0000'0000'0f0f'0f0fULL,
+    0x0000'0000'f0f0'f0f0ULL,
+    0x0f0f'0f0f'0000'0000ULL,
+    0xf0f0'f0f0'0000'0000ULL,
+};
+
+// The horizontal, vertical, diagonal and anti-diagonal lines of the board.
+struct Lines
+{
+    std::array<Bits, 8> rows{};
+    std::array<Bits, 8> columns{};
+    std::array<Bits, 15> diagonals{};
+    std::array<Bits, 15> anti_diagonals{};
+};
+
+constexpr Lines lines{[] {
+    auto result = Lines{};
+    for (auto row = 0; row < 8; ++row) {
+        for (auto column = 0; column < 8; ++column) {
+            const auto bit = Bits{1} << (row * 8 + column);
+            result.rows[row] |= bit;
+            result.columns[column] |= bit;
+            result.diagonals[row - column + 7] |= bit;
+            result.anti_diagonals[row + column] |= bit;
+        }
+    }
+    return result;
+}()};
+
+template <std::size_t N>
+Bits find_full_lines(const Bits occupied, const std::array<Bits, N>& line_bits)
+{
+    auto result = Bits{};
+    for (const auto line : line_bits) {
+        if ((occupied & line) == line) {
+            result |= line;
+        }
+    }
+    return result;
+}
+
+ZobristHash hash_bits(const Bits player, const Bits opponent)
+{
+    auto state = player;
+    state = opponent ^ next_splitmix64(state);
+    return next_splitmix64(state);
+}
+
+// The fields adjacent to each field. A move can only flip discs if one of its
+// neighbours belongs to the opponent.
+constexpr std::array<Bits, 64> neighbor_bits{[] {
+    auto result = std::array<Bits, 64>{};
+    for (auto i = 0; i < 64; ++i) {
+        for (const auto s : bit_shifts) {
+            result[i] |= shift_bits(Bits{1} << i, s.amount) & s.mask;
+        }
+    }
+    return result;
+}()};
+
+Bits find_flip_bits_for_index(const Bits player, const Bits opponent, const std::uint8_t index)
+{
+    if ((neighbor_bits[index] & opponent) == 0) {
+        return Bits{};
+    }
+    return find_flip_bits(player, opponent, Bits{1} << index);
+}
+
+int disc_difference(const Bits player, const Bits opponent)
+{
+    return std::popcount(player) - std::popcount(opponent);
+}
+
+// Empty fields in quadrants with an odd number of empty fields. Playing there
+// first tends to leave the last move in each region to the player to move.
+Bits find_odd_quadrant_bits(const Bits empty)
+{
+    auto result = Bits{};
+    for (const auto quadrant : quadrant_bits) {
+        if (std::popcount(empty & quadrant) % 2 == 1) {
+            result |= quadrant;
+        }
+    }
+    return result & empty;
+}
+
+// Appends the indices of `bits` to `indices`, starting at `size`.
+template <std::size_t N>
+void append_indices(Bits bits, std::array<std::uint8_t, N>& indices, std::size_t& size)
+{
+    for (; bits != 0 && size < N; bits &= bits - 1) {
+        indices[size++] = static_cast<std::uint8_t>(std::countr_zero(bits));
+    }
+}
+
+struct MoveCandidate
+{
+    Bits move;
+    Bits flips;
+    int rank;
+};
+
+using MoveCandidates = std::array<MoveCandidate, 64>;
+
+std::size_t order_moves(
+    const Bits player,
+    const Bits opponent,
+    const Bits moves,
+    const std::optional<Position> first_move,
+    MoveCandidates& candidates)
+{
+    const auto empty = ~(player | opponent);
+    const auto odd_quadrants = find_odd_quadrant_bits(empty);
+    const auto use_mobility = std::popcount(empty) >= min_empties_for_fastest_first;
+    auto size = std::size_t{};
+    for (auto bits = moves; bits != 0 && size < candidates.size(); bits &= bits - 1) {
+        const auto move = Bits{1} << std::countr_zero(bits);
+        const auto flips = find_flip_bits(player, opponent, move);
+        auto rank = (move & odd_quadrants) != 0 ? 0 : 1;
+        if (use_mobility) {
+            // Fastest first: prefer moves that leave the opponent few replies,
+            // especially few corners.
+            const auto next_player = opponent & ~flips;
+            const auto next_opponent = player | flips | move;
+            const auto opponent_moves = find_move_bits(next_player, next_opponent);
+            rank += 4
+                    * (std::popcount(opponent_moves)
+                       + std::popcount(opponent_moves & corner_bits));
+        }
+        if (first_move && move == position_bit(*first_move)) {
+            rank = std::numeric_limits<int>::min();
+        }
+        candidates[size++] = {move, flips, rank};
+    }
+    std::stable_sort(candidates.begin(), candidates.begin() + size, [](auto lhs, auto rhs) {
+        return lhs.rank < rhs.rank;
+    });
+    return size;
+}
+
+// The opponent keeps its stable discs, which bounds the result from above. Returns
+// the bound if it is no better than `alpha`, otherwise lowers `beta` to it.
+std::optional<int> apply_stability_cutoff(
+    const Bits player, const Bits opponent, const int num_empties, const int alpha, int& beta)
+{
+    if (num_empties >= min_empties_for_stability_cutoff
+        && alpha >= max_disc_difference - 2 * std::popcount(opponent)) {
+        const auto upper_bound
+            = max_disc_difference - 2 * std::popcount(find_stable_bits(opponent, player));
+        if (upper_bound <= alpha) {
+            return upper_bound;
+        }
+        beta = std::min(beta, upper_bound);
+    }
+    return std::nullopt;
+}
+
+// Narrows the window with a stored result for the position. Returns the stored score
+// if it decides the node.
+std::optional<int> probe_table(
+    const TranspositionTable& transposition_table,
+    const ZobristHash hash,
+    const int num_empties,
+    int& alpha,
+    int& beta,
+    std::optional<Position>& table_move)
+{
+    if (const auto entry = transposition_table.probe(hash);
+        entry && entry->depth == num_empties) {
+        table_move = entry->best_move;
+        switch (entry->bound) {
+        case Bound::exact: return entry->score;
+        case Bound::lower: alpha = std::max(alpha, entry->score); break;
+        case Bound::upper: beta = std::min(beta, entry->score); break;
+        }
+        if (alpha >= beta) {
+            return entry->score;
+        }
+    }
+    return std::nullopt;
+}
+
+void store_in_table(
+    TranspositionTable& transposition_table,
+    const ZobristHash hash,
+    const int num_empties,
+    const int best_score,
+    const int original_alpha,
+    const int beta,
+    const Bits best_move)
+{
+    const auto bound = best_score <= original_alpha ? Bound::upper
+                       : best_score >= beta         ? Bound::lower
+                                                    : Bound::exact;
+    transposition_table.store(
+        hash,
+        {best_score,
+         num_empties,
+         bound,
+         Position::from_linear_index(std::countr_zero(best_move))});
+}
+
+class Solver
+{
+public:
+    explicit Solver(TranspositionTable& transposition_table)
+        : transposition_table{transposition_table}
+    {}
+
+    std::uint64_t nodes{};
+
+    int solve(Bits player, Bits opponent, int alpha, int beta, bool opponent_passed);
+
+    int search_root(Bits player, Bits opponent, std::optional<Position>& best_move);
+
+private:
+    template <std::size_t N>
+    int solve_last(
+        Bits player,
+        Bits opponent,
+        int alpha,
+        int beta,
+        const std::array<std::uint8_t, N>& empties,
+        bool opponent_passed);
+
+    int solve_last_1(Bits player, Bits opponent, std::uint8_t empty);
+
+    int solve_last_4(Bits player, Bits opponent, int alpha, int beta);
+
+    TranspositionTable& transposition_table;
+};
+
+int Solver::search_root(
+    const Bits player, const Bits opponent, std::optional<Position>& best_move)
+{
+    ++nodes;
+    auto candidates = MoveCandidates{};
+    const auto num_candidates = order_moves(
+        player, opponent, find_move_bits(player, opponent), std::nullopt, candidates);
+    auto alpha = -max_disc_difference - 1;
+    for (std::size_t i = 0; i < num_candidates; ++i) {
+        const auto [move, flips, rank] = candidates[i];
+        const auto next_player = opponent & ~flips;
+        const auto next_opponent = player | flips | move;
+        auto score = i == 0 ? alpha + 1
+                            : -solve(next_player, next_opponent, -alpha - 1, -alpha, false);
+        if (score > alpha) {
+            score = -solve(next_player, next_opponent, -max_disc_difference - 1, -alpha, false);
+        }
+        if (score > alpha) {
+            alpha = score;
+            best_move = Position::from_linear_index(std::countr_zero(move));
+        }
+    }
+    return alpha;
+}
+
+int Solver::solve(
+    const Bits player, const Bits opponent, int alpha, int beta, const bool opponent_passed)
+{
+    const auto empty = ~(player | opponent);
+    const auto num_empties = std::popcount(empty);
+    if (num_empties <= 4 && !opponent_passed) {
+        return solve_last_4(player, opponent, alpha, beta);
+    }
+    ++nodes;
+
+    if (const auto bound = apply_stability_cutoff(player, opponent, num_empties, alpha, beta)) {
+        return *bound;
+    }
+
+    const auto moves = find_move_bits(player, opponent);
+    if (moves == 0) {
+        if (opponent_passed || find_move_bits(opponent, player) == 0) {
+            return disc_difference(player, opponent);
+        }
+        return -solve(opponent, player, -beta, -alpha, true);
+    }
+
+    const auto use_table = num_empties >= min_empties_for_transposition_table;
+    const auto hash = use_table ? hash_bits(player, opponent) : ZobristHash{};
+    auto table_move = std::optional<Position>{};
+    if (use_table) {
+        if (const auto score = probe_table(
+                transposition_table, hash, num_empties, alpha, beta, table_move)) {
+            return *score;
+        }
+    }
+
+    const auto original_alpha = alpha;
+    auto candidates = MoveCandidates{};
+    const auto num_candidates = order_moves(player, opponent, moves, table_move, candidates);
+    auto best_move = Bits{};
+    auto best_score = -max_disc_difference - 1;
+    for (std::size_t i = 0; i < num_candidates; ++i) {
+        const auto [move, flips, rank] = candidates[i];
+        const auto next_player = opponent & ~flips;
+        const auto next_opponent = player | flips | move;
+        auto score = 0;
+        if (i == 0) {
+            score = -solve(next_player, next_opponent, -beta, -alpha, false);
+        }
+        else {
+            // Principal variation search: a null window proves that the move is no
+            // better than the best one so far.
+            score = -solve(next_player, next_opponent, -alpha - 1, -alpha, false);
+            if (score > alpha && score < beta) {
+                score = -solve(next_player, next_opponent, -beta, -alpha, false);
+            }
+        }
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+            if (score >= beta) {
+                break;
+            }
+            alpha = std::max(alpha, score);
+        }
+    }
+
+    if (use_table) {
+        store_in_table(
+            transposition_table, hash, num_empties, best_score, original_alpha, beta, best_move);
+    }
+    return best_score;
+}
+
+int Solver::solve_last_4(const Bits player, const Bits opponent, const int alpha, const int beta)
+{
+    const auto empty = ~(player | opponent);
+    const auto odd_quadrants = find_odd_quadrant_bits(empty);
+    auto empties = std::array<std::uint8_t, 4>{};
+    auto size = std::size_t{};
+    append_indices(odd_quadrants, empties, size);
+    append_indices(empty & ~odd_quadrants, empties, size);
+
+    switch (size) {
+    case 0: return disc_difference(player, opponent);
+    case 1: return solve_last_1(player, opponent, empties[0]);
+    case 2:
+        return solve_last(
+            player, opponent, alpha, beta, std::array{empties[0], empties[1]}, false);
+    case 3:
+        return solve_last(
+            player,
+            opponent,
+            alpha,
+            beta,
+            std::array{empties[0], empties[1], empties[2]},
+            false);
+    default: return solve_last(player, opponent, alpha, beta, empties, false);
+    }
+}
+
+template <std::size_t N>
+int Solver::solve_last(
+    const Bits player,
+    const Bits opponent,
+    int alpha,
+    const int beta,
+    const std::array<std::uint8_t, N>& empties,
+    const bool opponent_passed)
+{
+    ++nodes;
+    auto best_score = -max_disc_difference - 1;
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto move = Bits{1} << empties[i];
+        const auto flips = find_flip_bits_for_index(player, opponent, empties[i]);
+        if (flips == 0) {
+            continue;
+        }
+        auto remaining_empties = std::array<std::uint8_t, N - 1>{};
+        std::copy(empties.begin(), empties.begin() + i, remaining_empties.begin());
+        std::copy(empties.begin() + i + 1, empties.end(), remaining_empties.begin() + i);
+
+        const auto next_player = opponent & ~flips;
+        const auto next_opponent = player | flips | move;
+        auto score = 0;
+        if constexpr (N == 2) {
+            score = -solve_last_1(next_player, next_opponent, remaining_empties[0]);
+        }
+        else {
+            score = -solve_last(
+                next_player, next_opponent, -beta, -alpha, remaining_empties, false);
+        }
+        if (score > best_score) {
+            best_score = score;
+            if (score >= beta) {
+                return best_score;
+            }
+            alpha = std::max(alpha, score);
+        }
+    }
+    if (best_score > -max_disc_difference - 1) {
+        return best_score;
+    }
+    if (opponent_passed) {
+        return disc_difference(player, opponent);
+    }
+    return -solve_last(opponent, player, -beta, -alpha, empties, true);
+}
+
+int Solver::solve_last_1(const Bits player, const Bits opponent, const std::uint8_t empty)
+{
+    ++nodes;
+    const auto difference = disc_difference(player, opponent);
+    if (const auto flips = find_flip_bits_for_index(player, opponent, empty); flips != 0) {
+        return difference + 2 * std::popcount(flips) + 1;
+    }
+    if (const auto flips = find_flip_bits_for_index(opponent, player, empty); flips != 0) {
+        return difference - 2 * std::popcount(flips) - 1;
+    }
+    return difference;
+}
+
+EndgameResult
+solve_sequentially(TranspositionTable& transposition_table, const Bits player, const Bits opponent)
+{
+    auto solver = Solver{transposition_table};
+    auto result = EndgameResult{};
+    if (find_move_bits(player, opponent) != 0) {
+        result.disc_difference = solver.search_root(player, opponent, result.best_move);
+    }
+    else {
+        result.disc_difference
+            = solver.solve(player, opponent, -max_disc_difference, max_disc_difference, false);
+    }
+    result.statistics.nodes = solver.nodes;
+    return result;
+}
+
+struct SplitPoint;
+
+// A younger sibling at a split point, offered to the other threads.
+struct SplitTask
+{
+    SplitPoint* split_point;
+    MoveCandidate candidate;
+};
+
+// A node whose eldest child has been searched and whose remaining children are
+// searched in parallel. Split points live on the stack of the thread that owns them,
+// which waits until all tasks are finished before it returns.
+struct SplitPoint
+{
+    SplitPoint(
+        const SplitPoint* parent,
+        const Bits player,
+        const Bits opponent,
+        const int alpha,
+        const int beta,
+        const int best_score,
+        const Bits best_move)
+        : parent{parent}
+        , player{player}
+        , opponent{opponent}
+        , beta{beta}
+        , alpha{alpha}
+        , best_score{best_score}
+        , best_move{best_move}
+    {}
+
+    const SplitPoint* parent;
+    const Bits player;
+    const Bits opponent;
+    const int beta;
+    // Set on a beta cutoff; the results of all nodes below are then meaningless.
+    std::atomic<bool> is_cut_off{false};
+    std::atomic<int> alpha;
+    std::atomic<std::size_t> num_pending_tasks{};
+    std::mutex mutex;
+    int best_score;
+    Bits best_move;
+    std::array<SplitTask, 64> tasks{};
+};
+
+bool is_aborted(const SplitPoint* split_point)
+{
+    for (; split_point != nullptr; split_point = split_point->parent) {
+        if (split_point->is_cut_off.load(std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+struct ParallelWorker
+{
+    explicit ParallelWorker(TranspositionTable& transposition_table)
+        : solver{transposition_table}
+    {}
+
+    Solver solver;
+    WorkStealingDeque<SplitTask> deque{split_deque_capacity};
+    std::size_t next_victim{};
+};
+
+// Young Brothers Wait: at a node with many empty fields, the eldest child is searched
+// first; if it does not cause a cutoff, the younger siblings are pushed onto the
+// deque of the thread and may be stolen by idle threads. The thread that owns a
+// split point searches its own tasks and then helps the other threads until all
+// tasks of the split point are finished. A beta cutoff at a split point aborts all
+// searches below it. Nodes with fewer empty fields are searched by the sequential
+// solver of each thread.
+class ParallelSolver
+{
+public:
+    ParallelSolver(TranspositionTable& transposition_table, const std::size_t num_threads)
+        : transposition_table{transposition_table}
+    {
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            workers.push_back(std::make_unique<ParallelWorker>(transposition_table));
+        }
+    }
+
+    int search_root(Bits player, Bits opponent, std::optional<Position>& best_move);
+
+    [[nodiscard]] std::uint64_t get_nodes() const;
+
+private:
+    int solve(
+        ParallelWorker& worker,
+        Bits player,
+        Bits opponent,
+        int alpha,
+        int beta,
+        bool opponent_passed,
+        const SplitPoint* parent,
+        Bits* root_move = nullptr);
+
+    void run_task(ParallelWorker& worker, SplitTask& task);
+
+    void finish_split_point(ParallelWorker& worker, SplitPoint& split_point);
+
+    void run_helper(ParallelWorker& worker);
+
+    [[nodiscard]] SplitTask* steal_task(ParallelWorker& thief);
+
+    TranspositionTable& transposition_table;
+    std::vector<std::unique_ptr<ParallelWorker>> workers;
+    std::atomic<bool> is_finished{false};
+};
+
+int ParallelSolver::search_root(
+    const Bits player, const Bits opponent, std::optional<Position>& best_move)
+{
+    auto root_move = Bits{};
+    auto score = 0;
+    {
+        auto helpers = std::vector<std::jthread>{};
+        for (std::size_t i = 1; i < workers.size(); ++i) {
+            helpers.emplace_back([this, &worker = *workers[i]] { run_helper(worker); });
+        }
+        score = solve(
+            *workers.front(),
+            player,
+            opponent,
+            -max_disc_difference,
+            max_disc_difference,
+            false,
+            nullptr,
+            &root_move);
+        is_finished.store(true, std::memory_order_release);
+    }
+    best_move = Position::from_linear_index(std::countr_zero(root_move));
+    return score;
+}
+
+std::uint64_t ParallelSolver::get_nodes() const
+{
+    auto result = std::uint64_t{};
+    for (const auto& worker : workers) {
+        result += worker->solver.nodes;
+    }
+    return result;
+}
+
+int ParallelSolver::solve(
+    ParallelWorker& worker,
+    const Bits player,
+    const Bits opponent,
+    int alpha,
+    int beta,
+    const bool opponent_passed,
+    const SplitPoint* parent,
+    Bits* root_move)
+{
+    const auto empty = ~(player | opponent);
+    const auto num_empties = std::popcount(empty);
+    if (num_empties < min_empties_for_split) {
+        return worker.solver.solve(player, opponent, alpha, beta, opponent_passed);
+    }
+    if (is_aborted(parent)) {
+        return 0;
+    }
+    ++worker.solver.nodes;
+
+    if (const auto bound = apply_stability_cutoff(player, opponent, num_empties, alpha, beta)) {
+        return *bound;
+    }
+
+    const auto moves = find_move_bits(player, opponent);
+    if (moves == 0) {
+        if (opponent_passed || find_move_bits(opponent, player) == 0) {
+            return disc_difference(player, opponent);
+        }
+        return -solve(worker, opponent, player, -beta, -alpha, true, parent);
+    }
+
+    // The root needs an exact score and a best move, so it only takes the move
+    // ordering from the table.
+    const auto hash = hash_bits(player, opponent);
+    auto table_move = std::optional<Position>{};
+    if (root_move == nullptr) {
+        if (const auto score = probe_table(
+                transposition_table, hash, num_empties, alpha, beta, table_move)) {
+            return *score;
+        }
+    }
+    else if (const auto entry = transposition_table.probe(hash)) {
+        table_move = entry->best_move;
+    }
+
+    const auto original_alpha = alpha;
+    auto candidates = MoveCandidates{};
+    const auto num_candidates = order_moves(player, opponent, moves, table_move, candidates);
+    const auto [eldest_move, eldest_flips, eldest_rank] = candidates[0];
+    auto best_score = -solve(
+        worker,
+        opponent & ~eldest_flips,
+        player | eldest_flips | eldest_move,
+        -beta,
+        -alpha,
+        false,
+        parent);
+    auto best_move = eldest_move;
+    if (best_score < beta && num_candidates > 1 && !is_aborted(parent)) {
+        auto split_point
+            = SplitPoint{parent, player, opponent, std::max(alpha, best_score), beta, best_score,
+                         best_move};
+        split_point.num_pending_tasks.store(num_candidates - 1, std::memory_order_relaxed);
+        for (std::size_t i = 1; i < num_candidates; ++i) {
+            split_point.tasks[i - 1] = {&split_point, candidates[i]};
+        }
+        // The best ordered siblings are pushed last, so that the owner searches them
+        // first while thieves take the least promising ones.
+        for (auto i = num_candidates - 1; i > 0; --i) {
+            if (!worker.deque.push(&split_point.tasks[i - 1])) {
+                run_task(worker, split_point.tasks[i - 1]);
+            }
+        }
+        finish_split_point(worker, split_point);
+        best_score = split_point.best_score;
+        best_move = split_point.best_move;
+    }
+    if (is_aborted(parent)) {
+        return 0;
+    }
+
+    store_in_table(
+        transposition_table, hash, num_empties, best_score, original_alpha, beta, best_move);
+    if (root_move != nullptr) {
+        *root_move = best_move;
+    }
+    return best_score;
+}
+
+void ParallelSolver::run_task(ParallelWorker& worker, SplitTask& task)
+{
+    auto& split_point = *task.split_point;
+    if (!is_aborted(&split_point)) {
+        const auto [move, flips, rank] = task.candidate;
+        const auto next_player = split_point.opponent & ~flips;
+        const auto next_opponent = split_point.player | flips | move;
+        const auto alpha = split_point.alpha.load(std::memory_order_relaxed);
+        const auto beta = split_point.beta;
+        auto score = -solve(
+            worker, next_player, next_opponent, -alpha - 1, -alpha, false, &split_point);
+        if (score > alpha && score < beta && !is_aborted(&split_point)) {
+            const auto current_alpha = split_point.alpha.load(std::memory_order_relaxed);
+            score = -solve(
+                worker, next_player, next_opponent, -beta, -current_alpha, false, &split_point);
+        }
+        if (!is_aborted(&split_point)) {
+            const auto lock = std::scoped_lock{split_point.mutex};
+            if (score > split_point.best_score) {
+                split_point.best_score = score;
+                split_point.best_move = move;
+                if (score >= beta) {
+                    split_point.is_cut_off.store(true, std::memory_order_relaxed);
+                }
+                else if (score > split_point.alpha.load(std::memory_order_relaxed)) {
+                    split_point.alpha.store(score, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+    split_point.num_pending_tasks.fetch_sub(1, std::memory_order_release);
+}
+
+void ParallelSolver::finish_split_point(ParallelWorker& worker, SplitPoint& split_point)
+{
+    // The tasks of the split point are at the bottom of the deque; below them are
+    // tasks of enclosing split points, which are left for other threads.
+    while (auto* task = worker.deque.pop()) {
+        if (task->split_point != &split_point) {
+            worker.deque.push(task);
+            break;
+        }
+        run_task(worker, *task);
+    }
+    while (split_point.num_pending_tasks.load(std::memory_order_acquire) > 0) {
+        if (auto* task = steal_task(worker)) {
+            run_task(worker, *task);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ParallelSolver::run_helper(ParallelWorker& worker)
+{
+    while (!is_finished.load(std::memory_order_acquire)) {
+        if (auto* task = steal_task(worker)) {
+            run_task(worker, *task);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+SplitTask* ParallelSolver::steal_task(ParallelWorker& thief)
+{
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        auto& victim = *workers[thief.next_victim++ % workers.size()];
+        if (&victim == &thief) {
+            continue;
+        }
+        if (auto* task = victim.deque.steal()) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+Bits find_stable_bits(const Bits player, const Bits opponent)
+{
+    const auto occupied = player | opponent;
+    const auto full_rows = find_full_lines(occupied, lines.rows);
+    const auto full_columns = find_full_lines(occupied, lines.columns);
+    const auto full_diagonals = find_full_lines(occupied, lines.diagonals);
+    const auto full_anti_diagonals = find_full_lines(occupied, lines.anti_diagonals);
+
+    // A disc is stable if, along each of the four lines through it, the line is full
+    // or one of its neighbours is the border or a stable disc of the same color.
+    auto result = Bits{};
+    while (true) {
+        const auto horizontal = full_rows | column_0_bits | column_7_bits
+                                | ((result << 1) & not_column_0_bits)
+                                | ((result >> 1) & not_column_7_bits);
+        const auto vertical
+            = full_columns | row_0_bits | row_7_bits | (result << 8) | (result >> 8);
+        const auto diagonal = full_diagonals | border_bits
+                              | ((result << 9) & not_column_0_bits)
+                              | ((result >> 9) & not_column_7_bits);
+        const auto anti_diagonal = full_anti_diagonals | border_bits
+                                   | ((result << 7) & not_column_7_bits)
+                                   | ((result >> 7) & not_column_0_bits);
+        const auto stable = player & horizontal & vertical & diagonal & anti_diagonal;
+        if (stable == result) {
+            return result;
+        }
+        result = stable;
+    }
+}
+
+EndgameSolver::EndgameSolver(const std::size_t transposition_table_size_in_mb)
+    : transposition_table{
+        std::make_shared<TranspositionTable>(transposition_table_size_in_mb)}
+{}
+
+EndgameResult EndgameSolver::solve(const Bits player, const Bits opponent) const
+{
+    const auto start_time = Clock::now();
+    transposition_table->new_search();
+    auto result = solve_sequentially(*transposition_table, player, opponent);
+    result.statistics.elapsed_time = Clock::now() - start_time;
+    result.statistics.completed_depth = std::popcount(~(player | opponent));
+    return result;
+}
+
+ParallelEndgameSolver::ParallelEndgameSolver(
+    const std::size_t num_threads, const std::size_t transposition_table_size_in_mb)
+    : num_threads{num_threads}
+    , transposition_table{
+        std::make_shared<TranspositionTable>(transposition_table_size_in_mb)}
+{
+    if (num_threads == 0) {
+        throw std::invalid_argument("A parallel solver needs at least one thread.");
+    }
+}
+
+EndgameResult ParallelEndgameSolver::solve(const Bits player, const Bits opponent) const
+{
+    const auto start_time = Clock::now();
+    const auto num_empties = std::popcount(~(player | opponent));
+    transposition_table->new_search();
+    auto result = EndgameResult{};
+    if (num_empties < min_empties_for_split || find_move_bits(player, opponent) == 0) {
+        result = solve_sequentially(*transposition_table, player, opponent);
+    }
+    else {
+        auto solver = ParallelSolver{*transposition_table, num_threads};
+        result.disc_difference = solver.search_root(player, opponent, result.best_move);
+        result.statistics.nodes = solver.get_nodes();
+    }
+    result.statistics.elapsed_time = Clock::now() - start_time;
+    result.statistics.completed_depth = num_empties;
+    return result;
+}
+
+} // namespace reviser::ai
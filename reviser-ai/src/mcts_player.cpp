@@ -0,0 +1,401 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "mcts_player.hpp"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bit_board.hpp"
+#include "random.hpp"
+
+namespace reviser::ai {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::uint32_t no_node{std::numeric_limits<std::uint32_t>::max()};
+constexpr std::uint8_t pass_move{64};
+constexpr std::uint64_t playouts_between_time_checks{64};
+// Passes included, a game has fewer moves than this.
+constexpr std::size_t max_path_length{128};
+
+constexpr std::uint8_t unexpanded{0};
+constexpr std::uint8_t expanding{1};
+constexpr std::uint8_t expanded{2};
+
+const MctsLimits& validate_limits(const MctsLimits& limits)
+{
+    if (limits.max_nodes < 2 || limits.max_nodes >= no_node || limits.num_threads == 0) {
+        throw std::invalid_argument("Invalid limits for Monte Carlo tree search.");
+    }
+    return limits;
+}
+
+// Results are counted in half points: 2 for a win, 1 for a draw and 0 for a loss.
+std::uint32_t compute_result(const Bits player, const Bits opponent)
+{
+    const auto player_discs = std::popcount(player);
+    const auto opponent_discs = std::popcount(opponent);
+    return player_discs > opponent_discs ? 2 : player_discs == opponent_discs ? 1 : 0;
+}
+
+} // namespace
+
+struct MctsSearch::Node
+{
+    // The position, from the point of view of the player to move.
+    Bits player{};
+    Bits opponent{};
+    std::atomic<std::uint32_t> visits{};
+    // The results for the player who moved to this node.
+    std::atomic<std::uint32_t> value{};
+    std::uint32_t first_child{};
+    std::uint8_t num_children{};
+    std::uint8_t move{};
+    std::atomic<std::uint8_t> state{};
+};
+
+// Runs playouts on one thread until the limits of the search are reached.
+class MctsSearch::Worker
+{
+public:
+    Worker(MctsSearch& search, const std::uint64_t seed)
+        : search{search}
+        , rng{seed}
+    {}
+
+    void run(
+        std::atomic<std::uint64_t>& num_playouts_started,
+        std::atomic<bool>& is_stopped,
+        const Clock::time_point start_time)
+    {
+        const auto& limits = search.limits;
+        while (!is_stopped.load(std::memory_order_relaxed)) {
+            const auto playout = num_playouts_started.fetch_add(1, std::memory_order_relaxed);
+            if (playout >= limits.max_playouts
+                || (limits.max_time != std::chrono::milliseconds::max()
+                    && playout % playouts_between_time_checks == 0
+                    && Clock::now() - start_time >= limits.max_time)) {
+                is_stopped.store(true, std::memory_order_relaxed);
+                break;
+            }
+            run_playout();
+        }
+    }
+
+private:
+    MctsSearch& search;
+    Xoshiro256 rng;
+    std::array<std::uint32_t, max_path_length> path{};
+
+    void run_playout()
+    {
+        auto* const nodes = search.nodes.get();
+        auto path_length = std::size_t{0};
+        auto index = search.root;
+        path[path_length++] = index;
+        nodes[index].visits.fetch_add(1, std::memory_order_relaxed);
+
+        while (true) {
+            auto& node = nodes[index];
+            if (node.state.load(std::memory_order_acquire) != expanded && !search.expand(index)) {
+                break;
+            }
+            if (node.num_children == 0) {
+                break;
+            }
+            index = select_child(node);
+            path[path_length++] = index;
+            const auto visits = nodes[index].visits.fetch_add(1, std::memory_order_relaxed);
+            if (visits == 0) {
+                break;
+            }
+        }
+
+        // `result` is from the point of view of the player to move at the node.
+        auto result = play_randomly(nodes[index].player, nodes[index].opponent);
+        while (path_length > 0) {
+            nodes[path[--path_length]].value.fetch_add(2 - result, std::memory_order_relaxed);
+            result = 2 - result;
+        }
+    }
+
+    [[nodiscard]] std::uint32_t select_child(const Node& node) const
+    {
+        const auto* const nodes = search.nodes.get();
+        const auto log_parent_visits
+            = std::log(static_cast<double>(node.visits.load(std::memory_order_relaxed)));
+        auto best_child = node.first_child;
+        auto best_score = -1.0;
+        for (auto child = node.first_child; child < node.first_child + node.num_children;
+             ++child) {
+            const auto visits = nodes[child].visits.load(std::memory_order_relaxed);
+            if (visits == 0) {
+                return child;
+            }
+            const auto value = nodes[child].value.load(std::memory_order_relaxed);
+            const auto score
+                = value / (2.0 * visits)
+                  + search.limits.exploration * std::sqrt(log_parent_visits / visits);
+            if (score > best_score) {
+                best_score = score;
+                best_child = child;
+            }
+        }
+        return best_child;
+    }
+
+    // Plays random moves until the end of the game and returns the result for the
+    // player to move in the initial position.
+    std::uint32_t play_randomly(Bits player, Bits opponent)
+    {
+        auto is_flipped = false;
+        auto opponent_passed = false;
+        while (true) {
+            auto moves = find_move_bits(player, opponent);
+            if (moves == 0) {
+                if (opponent_passed) {
+                    break;
+                }
+                opponent_passed = true;
+            }
+            else {
+                opponent_passed = false;
+                for (auto i = rng.uniform_index(std::popcount(moves)); i > 0; --i) {
+                    moves &= moves - 1;
+                }
+                const auto move = moves & -moves;
+                const auto flips = find_flip_bits(player, opponent, move);
+                player |= move | flips;
+                opponent &= ~flips;
+            }
+            std::swap(player, opponent);
+            is_flipped = !is_flipped;
+        }
+        return is_flipped ? compute_result(opponent, player) : compute_result(player, opponent);
+    }
+};
+
+double MctsStatistics::get_playouts_per_second() const
+{
+    const auto seconds = std::chrono::duration<double>{elapsed_time}.count();
+    return seconds > 0.0 ? static_cast<double>(playouts) / seconds : 0.0;
+}
+
+std::string MctsStatistics::to_string() const
+{
+    return std::format(
+        "{} playouts ({} reused), {} nodes in {:.3f}s ({:.0f} playouts/s)",
+        playouts,
+        reused_playouts,
+        num_nodes,
+        std::chrono::duration<double>{elapsed_time}.count(),
+        get_playouts_per_second());
+}
+
+MctsStatistics& MctsStatistics::operator+=(const MctsStatistics& other)
+{
+    playouts += other.playouts;
+    reused_playouts += other.reused_playouts;
+    num_nodes = std::max(num_nodes, other.num_nodes);
+    elapsed_time += other.elapsed_time;
+    return *this;
+}
+
+MctsSearch::MctsSearch(const MctsLimits limits, const std::uint64_t seed)
+    : limits{validate_limits(limits)}
+    , nodes{std::make_unique<Node[]>(limits.max_nodes)}
+    , root{no_node}
+    , seed{seed}
+{}
+
+MctsSearch::~MctsSearch() = default;
+
+void MctsSearch::set_limits(const MctsLimits& new_limits)
+{
+    if (validate_limits(new_limits).max_nodes != limits.max_nodes) {
+        nodes = std::make_unique<Node[]>(new_limits.max_nodes);
+        clear();
+    }
+    limits = new_limits;
+}
+
+MctsResult MctsSearch::search(const Bits player, const Bits opponent)
+{
+    const auto start_time = Clock::now();
+    root = find_or_create_root(player, opponent);
+    auto& root_node = nodes[root];
+    const auto reused_playouts = root_node.visits.load(std::memory_order_relaxed);
+    if (root_node.state.load(std::memory_order_relaxed) != expanded) {
+        expand(root);
+    }
+
+    auto num_playouts_started = std::atomic<std::uint64_t>{0};
+    auto is_stopped = std::atomic<bool>{false};
+    {
+        auto helpers = std::vector<std::jthread>{};
+        for (std::size_t i = 1; i < limits.num_threads; ++i) {
+            helpers.emplace_back([&, i] {
+                Worker{*this, seed + i}.run(num_playouts_started, is_stopped, start_time);
+            });
+        }
+        Worker{*this, seed}.run(num_playouts_started, is_stopped, start_time);
+    }
+    seed += limits.num_threads;
+
+    auto result = MctsResult{};
+    auto most_visits = std::uint32_t{0};
+    for (auto child = root_node.first_child;
+         child < root_node.first_child + root_node.num_children;
+         ++child) {
+        const auto visits = nodes[child].visits.load(std::memory_order_relaxed);
+        if (nodes[child].move != pass_move && (!result.best_move || visits > most_visits)) {
+            result.best_move = Position::from_linear_index(nodes[child].move);
+            most_visits = visits;
+        }
+    }
+    result.statistics = {
+        root_node.visits.load(std::memory_order_relaxed) - reused_playouts,
+        reused_playouts,
+        std::min<std::size_t>(num_nodes.load(std::memory_order_relaxed), limits.max_nodes),
+        Clock::now() - start_time};
+    return result;
+}
+
+void MctsSearch::clear()
+{
+    num_nodes.store(0, std::memory_order_relaxed);
+    root = no_node;
+}
+
+// The new position is usually two moves below the previous root. Only subtrees of
+// trees that fill less than half of the pool are reused, so that there is room to
+// grow them.
+std::uint32_t MctsSearch::find_or_create_root(const Bits player, const Bits opponent)
+{
+    if (root != no_node && num_nodes.load(std::memory_order_relaxed) < limits.max_nodes / 2) {
+        auto level = std::vector<std::uint32_t>{root};
+        for (auto depth = 0; depth < 4 && !level.empty(); ++depth) {
+            auto next_level = std::vector<std::uint32_t>{};
+            for (const auto index : level) {
+                const auto& node = nodes[index];
+                if (node.player == player && node.opponent == opponent) {
+                    return index;
+                }
+                if (node.state.load(std::memory_order_relaxed) == expanded) {
+                    for (std::uint32_t i = 0; i < node.num_children; ++i) {
+                        next_level.push_back(node.first_child + i);
+                    }
+                }
+            }
+            level = std::move(next_level);
+        }
+    }
+    clear();
+    const auto index = allocate_nodes(1);
+    initialize_node(index, player, opponent, pass_move);
+    return index;
+}
+
+std::uint32_t MctsSearch::allocate_nodes(const std::uint32_t count)
+{
+    if (num_nodes.load(std::memory_order_relaxed) + count > limits.max_nodes) {
+        return no_node;
+    }
+    const auto index = num_nodes.fetch_add(count, std::memory_order_relaxed);
+    return index + count <= limits.max_nodes ? index : no_node;
+}
+
+void MctsSearch::initialize_node(
+    const std::uint32_t index, const Bits player, const Bits opponent, const std::uint8_t move)
+{
+    auto& node = nodes[index];
+    node.player = player;
+    node.opponent = opponent;
+    node.visits.store(0, std::memory_order_relaxed);
+    node.value.store(0, std::memory_order_relaxed);
+    node.first_child = 0;
+    node.num_children = 0;
+    node.move = move;
+    node.state.store(unexpanded, std::memory_order_relaxed);
+}
+
+bool MctsSearch::expand(const std::uint32_t index)
+{
+    auto& node = nodes[index];
+    auto state = unexpanded;
+    if (!node.state.compare_exchange_strong(state, expanding, std::memory_order_acquire)) {
+        return state == expanded;
+    }
+
+    auto moves = find_move_bits(node.player, node.opponent);
+    const auto must_pass = moves == 0 && find_move_bits(node.opponent, node.player) != 0;
+    const auto num_children = must_pass ? 1 : std::popcount(moves);
+    if (num_children > 0) {
+        const auto first_child = allocate_nodes(static_cast<std::uint32_t>(num_children));
+        if (first_child == no_node) {
+            node.state.store(unexpanded, std::memory_order_relaxed);
+            return false;
+        }
+        if (must_pass) {
+            initialize_node(first_child, node.opponent, node.player, pass_move);
+        }
+        for (auto child = first_child; moves != 0; ++child, moves &= moves - 1) {
+            const auto move = moves & -moves;
+            const auto flips = find_flip_bits(node.player, node.opponent, move);
+            initialize_node(
+                child,
+                node.opponent & ~flips,
+                node.player | move | flips,
+                static_cast<std::uint8_t>(std::countr_zero(move)));
+        }
+        node.first_child = first_child;
+        node.num_children = static_cast<std::uint8_t>(num_children);
+    }
+    node.state.store(expanded, std::memory_order_release);
+    return true;
+}
+
+MctsPlayer::MctsPlayer(const std::string_view name, const MctsLimits& limits, const PlayerColor pc)
+    : Player{name, pc}
+    , search{limits, (std::uint64_t{std::random_device{}()} << 32) | std::random_device{}()}
+{}
+
+void MctsPlayer::new_game()
+{
+    search.clear();
+    total_statistics = {};
+}
+
+Position MctsPlayer::pick_move(const BasicBoard& board) const
+{
+    const auto player_field = field_for_player_color(get_color());
+    auto player = Bits{};
+    auto opponent = Bits{};
+    for (const auto pos : all_board_positions()) {
+        if (const Field field = board[pos]; field == player_field) {
+            player |= position_bit(pos);
+        }
+        else if (field != Field::empty) {
+            opponent |= position_bit(pos);
+        }
+    }
+
+    const auto result = search.search(player, opponent);
+    if (!result.best_move) {
+        throw std::invalid_argument("MCTS player has no valid move.");
+    }
+    last_statistics = result.statistics;
+    total_statistics += result.statistics;
+    return *result.best_move;
+}
+
+} // namespace reviser::ai
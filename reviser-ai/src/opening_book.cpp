@@ -0,0 +1,280 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "opening_book.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bit_board.hpp"
+
+namespace reviser::ai {
+
+namespace {
+
+template <typename T>
+T load_little_endian(const std::uint8_t* bytes)
+{
+    auto result = T{};
+    std::memcpy(&result, bytes, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big) {
+        result = std::byteswap(result);
+    }
+    return result;
+}
+
+template <typename T>
+void append_little_endian(std::string& buffer, T value)
+{
+    if constexpr (std::endian::native == std::endian::big) {
+        value = std::byteswap(value);
+    }
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.append(bytes, sizeof(T));
+}
+
+int compute_disc_difference(const Score score, const PlayerColor pc)
+{
+    const auto difference = score.get_num_dark_fields() - score.get_num_light_fields();
+    return pc == PlayerColor::dark ? difference : -difference;
+}
+
+} // namespace
+
+CanonicalHash compute_canonical_hash(
+    const Bits dark_bits, const Bits light_bits, const PlayerColor side_to_move)
+{
+    auto result = CanonicalHash{compute_zobrist_hash(dark_bits, light_bits, side_to_move)};
+    for (const auto symmetry : all_symmetries | std::views::drop(1)) {
+        const auto hash = compute_zobrist_hash(
+            transform_bits(dark_bits, symmetry),
+            transform_bits(light_bits, symmetry),
+            side_to_move);
+        if (hash < result.hash) {
+            result = {hash, symmetry};
+        }
+    }
+    return result;
+}
+
+OpeningBook::OpeningBook(const std::filesystem::path& path)
+    : mapped_file{std::in_place, path}
+    , data{mapped_file->get_data()}
+{
+    validate();
+}
+
+OpeningBook::OpeningBook(const std::span<const std::uint8_t> data)
+    : data{data}
+{
+    validate();
+}
+
+std::optional<BookMove> OpeningBook::find_move(
+    const Bits dark_bits, const Bits light_bits, const PlayerColor pc) const
+{
+    const auto canonical_hash = compute_canonical_hash(dark_bits, light_bits, pc);
+    const auto* entries = data.data() + opening_book_header_size;
+
+    auto first = std::size_t{0};
+    auto count = num_entries;
+    while (count > 0) {
+        const auto step = count / 2;
+        const auto middle = first + step;
+        if (load_little_endian<std::uint64_t>(entries + middle * opening_book_entry_size)
+            < canonical_hash.hash) {
+            first = middle + 1;
+            count -= step + 1;
+        }
+        else {
+            count = step;
+        }
+    }
+    if (first == num_entries) {
+        return std::nullopt;
+    }
+    const auto* entry = entries + first * opening_book_entry_size;
+    if (load_little_endian<std::uint64_t>(entry) != canonical_hash.hash || entry[8] >= 64) {
+        return std::nullopt;
+    }
+    return BookMove{
+        transform_position(
+            Position::from_linear_index(entry[8]), inverse(canonical_hash.symmetry)),
+        load_little_endian<std::int16_t>(entry + 10),
+        load_little_endian<std::uint32_t>(entry + 12)};
+}
+
+std::optional<BookMove>
+OpeningBook::find_move(const BasicBoard& board, const PlayerColor pc) const
+{
+    const auto bit_board = copy_board_as<BitBoard>(board);
+    return find_move(
+        bit_board.get_bits_for(PlayerColor::dark), bit_board.get_bits_for(PlayerColor::light), pc);
+}
+
+void OpeningBook::validate()
+{
+    if (data.size() < opening_book_header_size
+        || std::string_view{reinterpret_cast<const char*>(data.data()), 4}
+               != opening_book_magic
+        || load_little_endian<std::uint32_t>(data.data() + 4) != opening_book_version) {
+        throw std::invalid_argument("Data is not an opening book.");
+    }
+    num_entries = load_little_endian<std::uint64_t>(data.data() + 8);
+    if (num_entries > (data.size() - opening_book_header_size) / opening_book_entry_size) {
+        throw std::invalid_argument("Opening book is truncated.");
+    }
+}
+
+void OpeningBookBuilder::add_move(
+    const Bits dark_bits,
+    const Bits light_bits,
+    const PlayerColor pc,
+    const Position move,
+    const int score,
+    const std::uint32_t count)
+{
+    const auto canonical_hash = compute_canonical_hash(dark_bits, light_bits, pc);
+    const auto canonical_move = transform_position(move, canonical_hash.symmetry);
+    auto& statistics = moves[{
+        canonical_hash.hash, static_cast<std::uint8_t>(canonical_move.to_linear_index())}];
+    statistics.total_score += std::int64_t{score} * count;
+    statistics.count += count;
+}
+
+void OpeningBookBuilder::add_move(
+    const BitBoard& board,
+    const PlayerColor pc,
+    const Position move,
+    const int score,
+    const std::uint32_t count)
+{
+    add_move(
+        board.get_bits_for(PlayerColor::dark),
+        board.get_bits_for(PlayerColor::light),
+        pc,
+        move,
+        score,
+        count);
+}
+
+void OpeningBookBuilder::add_game(const GameRecord& record, const std::size_t max_num_moves)
+{
+    if (record.result_type == GameResultType::win_by_opponent_mistake) {
+        return;
+    }
+    auto board = BitBoard{};
+    board.initialize();
+    auto pc = PlayerColor::dark;
+    auto num_moves = std::size_t{0};
+    for (const auto move : record.moves) {
+        if (num_moves == max_num_moves) {
+            break;
+        }
+        if (move != game_record_pass) {
+            const auto pos = Position::from_linear_index(move);
+            add_move(board, pc, pos, compute_disc_difference(record.score, pc));
+            if (!board.play_move(pc, pos).was_played()) {
+                throw std::invalid_argument("Game record contains an invalid move.");
+            }
+            ++num_moves;
+        }
+        pc = other_player_color(pc);
+    }
+}
+
+void OpeningBookBuilder::add_game(const WthorGame& game, const std::size_t max_num_moves)
+{
+    // WTHOR scores count the empty fields for the winner.
+    const auto num_dark_discs = game.get_num_dark_discs();
+    const auto score = Score{
+        static_cast<int_fast8_t>(num_dark_discs),
+        static_cast<int_fast8_t>(64 - num_dark_discs),
+        0};
+    auto board = BitBoard{};
+    board.initialize();
+    auto pc = PlayerColor::dark;
+    for (const auto pos : game.get_moves() | std::views::take(max_num_moves)) {
+        if (!board.is_valid_move(pc, pos)) {
+            pc = other_player_color(pc);
+        }
+        add_move(board, pc, pos, compute_disc_difference(score, pc));
+        if (!board.play_move(pc, pos).was_played()) {
+            throw std::invalid_argument("WTHOR game contains an invalid move.");
+        }
+        pc = other_player_color(pc);
+    }
+}
+
+std::size_t OpeningBookBuilder::get_num_positions() const
+{
+    auto result = std::size_t{0};
+    for (auto it = moves.begin(); it != moves.end();
+         it = moves.upper_bound({it->first.first, 64})) {
+        ++result;
+    }
+    return result;
+}
+
+void OpeningBookBuilder::write(std::ostream& out) const
+{
+    auto entries = std::string{};
+    auto num_entries = std::uint64_t{0};
+    for (auto first = moves.begin(); first != moves.end();) {
+        const auto hash = first->first.first;
+        const auto last = moves.upper_bound({hash, 64});
+        auto max_count = std::uint32_t{0};
+        for (auto it = first; it != last; ++it) {
+            max_count = std::max(max_count, it->second.count);
+        }
+
+        auto best = last;
+        auto best_score = std::numeric_limits<std::int64_t>::min();
+        for (auto it = first; it != last; ++it) {
+            const auto& [total_score, count] = it->second;
+            const auto score = total_score / count;
+            if (2 * std::uint64_t{count} >= max_count
+                && (score > best_score || (score == best_score && count > best->second.count))) {
+                best = it;
+                best_score = score;
+            }
+        }
+
+        append_little_endian(entries, hash);
+        entries.push_back(static_cast<char>(best->first.second));
+        entries.push_back('\0');
+        append_little_endian(
+            entries,
+            static_cast<std::int16_t>(std::clamp<std::int64_t>(
+                best_score,
+                std::numeric_limits<std::int16_t>::min(),
+                std::numeric_limits<std::int16_t>::max())));
+        append_little_endian(entries, best->second.count);
+        ++num_entries;
+        first = last;
+    }
+
+    auto header = std::string{opening_book_magic};
+    append_little_endian(header, opening_book_version);
+    append_little_endian(header, num_entries);
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(entries.data(), static_cast<std::streamsize>(entries.size()));
+}
+
+void OpeningBookBuilder::write(const std::filesystem::path& path) const
+{
+    auto out = std::ofstream{path, std::ios::binary};
+    write(out);
+    if (!out) {
+        throw std::invalid_argument("Could not write opening book " + path.string() + ".");
+    }
+}
+
+} // namespace reviser::ai
@@ -0,0 +1,235 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "pattern_evaluator.hpp"
+
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "evaluation.hpp"
+
+namespace reviser::ai {
+
+namespace {
+
+template <typename T>
+T load_little_endian(const char* bytes)
+{
+    auto result = T{};
+    std::memcpy(&result, bytes, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big) {
+        result = std::byteswap(result);
+    }
+    return result;
+}
+
+template <typename T>
+void append_little_endian(std::string& buffer, T value)
+{
+    if constexpr (std::endian::native == std::endian::big) {
+        value = std::byteswap(value);
+    }
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.append(bytes, sizeof(T));
+}
+
+constexpr std::size_t pattern_weights_header_size{16};
+
+// Rounds `numerator / denominator` half away from zero, so that weights of
+// configurations with exchanged colors are exact negations of each other.
+std::int16_t round_quotient(const std::int64_t numerator, const std::int64_t denominator)
+{
+    const auto magnitude = (std::abs(numerator) + denominator / 2) / denominator;
+    return static_cast<std::int16_t>(numerator < 0 ? -magnitude : magnitude);
+}
+
+PatternWeights make_default_weights()
+{
+    // Every field contributes its value once, divided among all instances that
+    // contain it. Symmetric fields have the same value and coverage, therefore the
+    // fields of the base pattern can be used for all instances. The shares are
+    // computed as integer fractions so that rounding does not depend on the order
+    // of the fields.
+    auto denominator = std::int64_t{1};
+    for (const auto& patterns : field_patterns) {
+        denominator = std::lcm(denominator, static_cast<std::int64_t>(patterns.size));
+    }
+
+    auto result = PatternWeights{1};
+    const auto weights = result.get_weights(0);
+    auto weight_offset = std::size_t{0};
+    for (const auto& type : pattern_types) {
+        auto field_weights = std::array<std::int64_t, 10>{};
+        for (std::size_t i = 0; i < type.num_fields; ++i) {
+            const auto field = type.fields[i];
+            field_weights[i] = field_values[field] * denominator
+                               / static_cast<std::int64_t>(field_patterns[field].size);
+        }
+        for (std::size_t index = 0; index < type.get_num_configurations(); ++index) {
+            auto value = std::int64_t{0};
+            auto digits = index;
+            for (std::size_t i = 0; i < type.num_fields; ++i, digits /= 3) {
+                if (digits % 3 == 1) {
+                    value += field_weights[i];
+                }
+                else if (digits % 3 == 2) {
+                    value -= field_weights[i];
+                }
+            }
+            weights[weight_offset + index] = round_quotient(value, denominator);
+        }
+        weight_offset += type.get_num_configurations();
+    }
+    return result;
+}
+
+} // namespace
+
+PatternIndices compute_pattern_indices(const Bits dark_bits, const Bits light_bits)
+{
+    auto result = PatternIndices{};
+    auto& dark_indices = result.indices[static_cast<std::size_t>(PlayerColor::dark)];
+    auto& light_indices = result.indices[static_cast<std::size_t>(PlayerColor::light)];
+    for (std::size_t i = 0; i < num_pattern_instances; ++i) {
+        const auto& instance = pattern_instances[i];
+        auto power = std::uint16_t{1};
+        for (std::size_t j = 0; j < instance.num_fields; ++j, power *= 3) {
+            const auto bit = Bits{1} << instance.fields[j];
+            if (dark_bits & bit) {
+                dark_indices[i] += power;
+                light_indices[i] += 2 * power;
+            }
+            else if (light_bits & bit) {
+                dark_indices[i] += 2 * power;
+                light_indices[i] += power;
+            }
+        }
+    }
+    return result;
+}
+
+PatternWeights::PatternWeights(const std::size_t num_phases)
+    : num_phases{num_phases}
+    , weights(num_phases * num_weights_per_phase)
+{
+    if (num_phases == 0 || num_phases > 61) {
+        throw std::invalid_argument("The number of phases must be between 1 and 61.");
+    }
+}
+
+std::shared_ptr<const PatternWeights> PatternWeights::get_default()
+{
+    static const auto default_weights
+        = std::make_shared<const PatternWeights>(make_default_weights());
+    return default_weights;
+}
+
+PatternWeights PatternWeights::load(const std::filesystem::path& path)
+{
+    auto in = std::ifstream{path, std::ios::binary};
+    const auto contents
+        = std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    if (!in.good() && !in.eof()) {
+        throw std::invalid_argument("Could not read pattern weights " + path.string() + ".");
+    }
+    if (contents.size() < pattern_weights_header_size
+        || std::string_view{contents}.substr(0, 4) != pattern_weights_magic) {
+        throw std::invalid_argument(path.string() + " does not contain pattern weights.");
+    }
+    if (load_little_endian<std::uint32_t>(contents.data() + 4) != pattern_weights_version) {
+        throw std::invalid_argument("Unsupported version of pattern weights " + path.string() + ".");
+    }
+    const auto num_phases = load_little_endian<std::uint32_t>(contents.data() + 8);
+    const auto num_weights = load_little_endian<std::uint32_t>(contents.data() + 12);
+    if (num_weights != num_weights_per_phase || num_phases == 0 || num_phases > 61
+        || contents.size()
+               != pattern_weights_header_size + num_phases * num_weights * sizeof(std::int16_t)) {
+        throw std::invalid_argument(path.string() + " does not match the patterns.");
+    }
+
+    auto result = PatternWeights{num_phases};
+    const auto* data = contents.data() + pattern_weights_header_size;
+    for (auto& weight : result.weights) {
+        weight = load_little_endian<std::int16_t>(data);
+        data += sizeof(std::int16_t);
+    }
+    return result;
+}
+
+void PatternWeights::save(const std::filesystem::path& path) const
+{
+    auto buffer = std::string{pattern_weights_magic};
+    append_little_endian(buffer, pattern_weights_version);
+    append_little_endian(buffer, static_cast<std::uint32_t>(num_phases));
+    append_little_endian(buffer, static_cast<std::uint32_t>(num_weights_per_phase));
+    for (const auto weight : weights) {
+        append_little_endian(buffer, weight);
+    }
+
+    auto out = std::ofstream{path, std::ios::binary};
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!out) {
+        throw std::invalid_argument("Could not write pattern weights " + path.string() + ".");
+    }
+}
+
+PatternEvaluator::PatternEvaluator(std::shared_ptr<const PatternWeights> weights)
+    : weights{std::move(weights)}
+{
+    if (!this->weights) {
+        throw std::invalid_argument("A pattern evaluator needs weights.");
+    }
+}
+
+void PatternEvaluator::play_move(const FlipRecord& record)
+{
+    if (record.was_played()) {
+        update_indices(record, 1);
+        ++num_discs;
+    }
+}
+
+void PatternEvaluator::undo_move(const FlipRecord& record)
+{
+    if (record.was_played()) {
+        update_indices(record, -1);
+        --num_discs;
+    }
+}
+
+// A new disc adds its digit to both perspectives; a flipped disc changes its digit
+// from 2 to 1 for the mover and from 1 to 2 for the opponent.
+void PatternEvaluator::update_indices(const FlipRecord& record, const int direction)
+{
+    auto& player_indices = indices.indices[static_cast<std::size_t>(record.player_color)];
+    auto& opponent_indices
+        = indices.indices[static_cast<std::size_t>(other_player_color(record.player_color))];
+
+    const auto& move_patterns = field_patterns[record.move.to_linear_index()];
+    for (std::size_t i = 0; i < move_patterns.size; ++i) {
+        const auto [instance, power] = move_patterns.entries[i];
+        player_indices[instance] = static_cast<std::uint16_t>(
+            player_indices[instance] + direction * power);
+        opponent_indices[instance] = static_cast<std::uint16_t>(
+            opponent_indices[instance] + direction * 2 * power);
+    }
+
+    for (const auto pos : record.flipped_positions) {
+        const auto& patterns = field_patterns[pos.to_linear_index()];
+        for (std::size_t i = 0; i < patterns.size; ++i) {
+            const auto [instance, power] = patterns.entries[i];
+            player_indices[instance]
+                = static_cast<std::uint16_t>(player_indices[instance] - direction * power);
+            opponent_indices[instance]
+                = static_cast<std::uint16_t>(opponent_indices[instance] + direction * power);
+        }
+    }
+}
+
+} // namespace reviser::ai
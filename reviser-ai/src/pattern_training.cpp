@@ -0,0 +1,185 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "pattern_training.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "bit_board.hpp"
+
+namespace reviser::ai {
+
+namespace {
+
+// Calls `function(thread_index, begin, end)` on `num_threads` threads for equally
+// sized parts of the range [0, size).
+template <typename FunctionT>
+void run_in_parallel(
+    const std::size_t num_threads, const std::size_t size, const FunctionT& function)
+{
+    auto threads = std::vector<std::jthread>{};
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(function, i, i * size / num_threads, (i + 1) * size / num_threads);
+    }
+}
+
+int compute_disc_difference(const Score score)
+{
+    return score.get_num_dark_fields() - score.get_num_light_fields();
+}
+
+} // namespace
+
+std::size_t TrainingSet::add_game(const GameRecord& record)
+{
+    if (record.result_type == GameResultType::win_by_opponent_mistake) {
+        return 0;
+    }
+    const auto final_disc_difference = compute_disc_difference(record.score);
+    const auto initial_size = positions.size();
+    auto board = BitBoard{};
+    board.initialize();
+    evaluator.set_board(board);
+    auto pc = PlayerColor::dark;
+    for (const auto move : record.moves) {
+        if (move != game_record_pass) {
+            if (move > game_record_pass
+                || !board.is_valid_move(pc, Position::from_linear_index(move))) {
+                positions.resize(initial_size);
+                throw std::invalid_argument("Game record contains an invalid move.");
+            }
+            add_position(pc, final_disc_difference);
+            evaluator.play_move(board.play_move(pc, Position::from_linear_index(move)));
+        }
+        pc = other_player_color(pc);
+    }
+    return positions.size() - initial_size;
+}
+
+std::size_t TrainingSet::add_game(const WthorGame& game)
+{
+    // WTHOR scores count the empty fields for the winner.
+    const auto final_disc_difference = 2 * game.get_num_dark_discs() - 64;
+    const auto initial_size = positions.size();
+    auto board = BitBoard{};
+    board.initialize();
+    evaluator.set_board(board);
+    auto pc = PlayerColor::dark;
+    for (const auto pos : game.get_moves()) {
+        if (!board.is_valid_move(pc, pos)) {
+            pc = other_player_color(pc);
+            if (!board.is_valid_move(pc, pos)) {
+                positions.resize(initial_size);
+                throw std::invalid_argument("WTHOR game contains an invalid move.");
+            }
+        }
+        add_position(pc, final_disc_difference);
+        evaluator.play_move(board.play_move(pc, pos));
+        pc = other_player_color(pc);
+    }
+    return positions.size() - initial_size;
+}
+
+void TrainingSet::add_position(const PlayerColor pc, const int final_dark_disc_difference)
+{
+    auto& position = positions.emplace_back();
+    position.indices = evaluator.get_indices().for_player(pc);
+    position.num_discs = static_cast<std::int8_t>(evaluator.get_num_discs());
+    position.disc_difference = static_cast<std::int8_t>(
+        pc == PlayerColor::dark ? final_dark_disc_difference : -final_dark_disc_difference);
+}
+
+PatternWeights train_pattern_weights(
+    const TrainingSet& training_set, const TrainingConfig& config, const TrainingProgress& progress)
+{
+    const auto& positions = training_set.get_positions();
+    if (positions.empty()) {
+        throw std::invalid_argument("Cannot train pattern weights without positions.");
+    }
+    auto result = PatternWeights{config.num_phases};
+    const auto num_threads = std::clamp<std::size_t>(config.num_threads, 1, positions.size());
+    const auto num_weights = config.num_phases * num_weights_per_phase;
+
+    // The offsets of the weights of each position, computed once for all epochs.
+    auto offsets = std::vector<std::array<std::uint32_t, num_pattern_instances>>(positions.size());
+    auto thread_counts = std::vector<std::vector<std::uint32_t>>(num_threads);
+    run_in_parallel(num_threads, positions.size(), [&](const std::size_t thread, const std::size_t begin, const std::size_t end) {
+        auto& counts = thread_counts[thread];
+        counts.resize(num_weights);
+        for (auto i = begin; i < end; ++i) {
+            const auto phase_offset
+                = result.get_phase(positions[i].num_discs) * num_weights_per_phase;
+            for (std::size_t j = 0; j < num_pattern_instances; ++j) {
+                const auto offset = static_cast<std::uint32_t>(
+                    phase_offset + pattern_instances[j].weight_offset + positions[i].indices[j]);
+                offsets[i][j] = offset;
+                ++counts[offset];
+            }
+        }
+    });
+
+    auto weights = std::vector<double>(num_weights);
+    auto thread_error_sums = std::vector<std::vector<double>>(num_threads);
+    auto thread_squared_errors = std::vector<double>(num_threads);
+    const auto step = config.learning_rate / static_cast<double>(num_pattern_instances);
+    for (std::size_t epoch = 1; epoch <= config.num_epochs; ++epoch) {
+        run_in_parallel(num_threads, positions.size(), [&](const std::size_t thread, const std::size_t begin, const std::size_t end) {
+            auto& error_sums = thread_error_sums[thread];
+            error_sums.assign(num_weights, 0.0);
+            auto squared_error = 0.0;
+            for (auto i = begin; i < end; ++i) {
+                auto prediction = 0.0;
+                for (const auto offset : offsets[i]) {
+                    prediction += weights[offset];
+                }
+                const auto error
+                    = positions[i].disc_difference * pattern_score_scale - prediction;
+                squared_error += error * error;
+                for (const auto offset : offsets[i]) {
+                    error_sums[offset] += error;
+                }
+            }
+            thread_squared_errors[thread] = squared_error;
+        });
+
+        // The weights are updated in parallel as well, each thread for its part.
+        run_in_parallel(num_threads, num_weights, [&](std::size_t, const std::size_t begin, const std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                auto error_sum = 0.0;
+                auto count = std::uint32_t{0};
+                for (std::size_t thread = 0; thread < num_threads; ++thread) {
+                    error_sum += thread_error_sums[thread][i];
+                    count += thread_counts[thread][i];
+                }
+                if (count > 0) {
+                    weights[i] += step * error_sum / count;
+                }
+            }
+        });
+
+        if (progress) {
+            auto squared_error = 0.0;
+            for (const auto thread_squared_error : thread_squared_errors) {
+                squared_error += thread_squared_error;
+            }
+            progress(
+                epoch,
+                squared_error / static_cast<double>(positions.size())
+                    / (pattern_score_scale * pattern_score_scale));
+        }
+    }
+
+    for (std::size_t phase = 0; phase < config.num_phases; ++phase) {
+        const auto phase_weights = result.get_weights(phase);
+        for (std::size_t i = 0; i < num_weights_per_phase; ++i) {
+            phase_weights[i] = static_cast<std::int16_t>(std::clamp<long>(
+                std::lround(weights[phase * num_weights_per_phase + i]),
+                std::numeric_limits<std::int16_t>::min(),
+                std::numeric_limits<std::int16_t>::max()));
+        }
+    }
+    return result;
+}
+
+} // namespace reviser::ai
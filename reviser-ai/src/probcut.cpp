@@ -0,0 +1,244 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "probcut.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "evaluation.hpp"
+
+namespace reviser::ai {
+
+namespace {
+
+constexpr auto probcut_header{"probcut"};
+constexpr int probcut_version{1};
+
+// Fitted with reviser-probcut to 600 positions from games between a random player
+// and a search of depth 2, searched with the default pattern weights, for four
+// stages and depths 3 to 10.
+constexpr std::size_t default_num_stages{4};
+constexpr int default_max_depth{10};
+constexpr std::array default_regressions{
+    // Stage 0
+    ProbCutRegression{1.000, 0.3, 3.8},
+    ProbCutRegression{0.997, -0.3, 2.5},
+    ProbCutRegression{0.985, 0.4, 2.3},
+    ProbCutRegression{0.992, -0.3, 3.3},
+    ProbCutRegression{0.979, 1.0, 3.1},
+    ProbCutRegression{1.025, -0.3, 3.5},
+    ProbCutRegression{1.037, 0.9, 3.6},
+    ProbCutRegression{1.060, -0.4, 5.1},
+    // Stage 1
+    ProbCutRegression{1.052, 2.4, 18.6},
+    ProbCutRegression{1.064, 0.6, 18.9},
+    ProbCutRegression{1.080, -0.6, 16.0},
+    ProbCutRegression{1.119, 1.3, 22.9},
+    ProbCutRegression{1.139, 0.0, 21.7},
+    ProbCutRegression{1.131, 2.5, 23.9},
+    ProbCutRegression{1.139, 1.9, 24.7},
+    ProbCutRegression{1.222, 2.6, 32.4},
+    // Stage 2
+    ProbCutRegression{1.042, -1.2, 52.5},
+    ProbCutRegression{1.022, 2.2, 33.2},
+    ProbCutRegression{1.028, 1.5, 29.0},
+    ProbCutRegression{1.060, 9.0, 52.3},
+    ProbCutRegression{1.057, 10.8, 42.5},
+    ProbCutRegression{1.070, 13.1, 41.8},
+    ProbCutRegression{1.075, 10.4, 42.2},
+    ProbCutRegression{1.117, 15.5, 54.6},
+    // Stage 3
+    ProbCutRegression{1.037, 3.2, 43.0},
+    ProbCutRegression{1.006, 2.2, 25.0},
+    ProbCutRegression{1.006, -2.2, 32.9},
+    ProbCutRegression{1.017, 8.5, 44.1},
+    ProbCutRegression{1.022, -1.7, 48.8},
+    ProbCutRegression{1.014, 10.8, 52.3},
+    ProbCutRegression{1.026, 0.2, 44.9},
+    ProbCutRegression{1.023, 17.1, 59.5},
+};
+static_assert(
+    default_regressions.size()
+    == default_num_stages * (default_max_depth - ProbCutParameters::min_depth + 1));
+
+ProbCutParameters make_default_parameters()
+{
+    auto result = ProbCutParameters{default_num_stages, default_max_depth};
+    auto regression = default_regressions.begin();
+    for (std::size_t stage = 0; stage < default_num_stages; ++stage) {
+        for (auto depth = ProbCutParameters::min_depth; depth <= default_max_depth; ++depth) {
+            result.set_regression(stage, depth, *regression++);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+ProbCutParameters::ProbCutParameters(const std::size_t num_stages, const int max_depth)
+    : num_stages{num_stages}
+    , max_depth{max_depth}
+{
+    if (num_stages == 0 || num_stages > 61) {
+        throw std::invalid_argument("The number of stages must be between 1 and 61.");
+    }
+    if (max_depth < min_depth || max_depth > 60) {
+        throw std::invalid_argument("The maximum ProbCut depth must be between 3 and 60.");
+    }
+    regressions.resize(num_stages * static_cast<std::size_t>(max_depth - min_depth + 1));
+}
+
+std::shared_ptr<const ProbCutParameters> ProbCutParameters::get_default()
+{
+    static const auto default_parameters
+        = std::make_shared<const ProbCutParameters>(make_default_parameters());
+    return default_parameters;
+}
+
+ProbCutParameters ProbCutParameters::load(const std::filesystem::path& path)
+{
+    auto in = std::ifstream{path};
+    if (!in) {
+        throw std::invalid_argument("Could not read ProbCut parameters " + path.string() + ".");
+    }
+    auto header = std::string{};
+    auto version = 0;
+    auto num_stages = std::size_t{};
+    auto max_depth = 0;
+    if (!(in >> header >> version >> num_stages >> max_depth) || header != probcut_header) {
+        throw std::invalid_argument(path.string() + " does not contain ProbCut parameters.");
+    }
+    if (version != probcut_version) {
+        throw std::invalid_argument(
+            "Unsupported version of ProbCut parameters " + path.string() + ".");
+    }
+
+    auto result = ProbCutParameters{num_stages, max_depth};
+    auto stage = std::size_t{};
+    auto depth = 0;
+    auto regression = ProbCutRegression{};
+    while (in >> stage >> depth >> regression.slope >> regression.intercept >> regression.sigma) {
+        if (stage >= num_stages || depth < min_depth || depth > max_depth) {
+            throw std::invalid_argument(path.string() + " contains an invalid regression.");
+        }
+        result.set_regression(stage, depth, regression);
+    }
+    if (!in.eof()) {
+        throw std::invalid_argument(path.string() + " contains an invalid regression.");
+    }
+    return result;
+}
+
+void ProbCutParameters::save(const std::filesystem::path& path) const
+{
+    auto out = std::ofstream{path};
+    out << probcut_header << ' ' << probcut_version << ' ' << num_stages << ' ' << max_depth
+        << '\n';
+    out.precision(9);
+    for (std::size_t stage = 0; stage < num_stages; ++stage) {
+        for (auto depth = min_depth; depth <= max_depth; ++depth) {
+            const auto& regression = get_regression(stage, depth);
+            out << stage << ' ' << depth << ' ' << regression.slope << ' '
+                << regression.intercept << ' ' << regression.sigma << '\n';
+        }
+    }
+    if (!out) {
+        throw std::invalid_argument("Could not write ProbCut parameters " + path.string() + ".");
+    }
+}
+
+int ProbCutParameters::get_shallow_depth(const int depth) noexcept
+{
+    const auto result = (depth + 1) / 2;
+    return (depth - result) % 2 == 0 ? result : result - 1;
+}
+
+const ProbCutRegression&
+ProbCutParameters::get_regression(const std::size_t stage, const int depth) const
+{
+    return regressions[index_of(stage, depth)];
+}
+
+void ProbCutParameters::set_regression(
+    const std::size_t stage, const int depth, const ProbCutRegression& regression)
+{
+    regressions[index_of(stage, depth)] = regression;
+}
+
+void ProbCutParameters::set_cut_threshold(const double threshold)
+{
+    if (!(threshold >= 0.0)) {
+        throw std::invalid_argument("The cut threshold must not be negative.");
+    }
+    cut_threshold = threshold;
+}
+
+std::size_t ProbCutParameters::index_of(const std::size_t stage, const int depth) const
+{
+    if (stage >= num_stages || depth < min_depth || depth > max_depth) {
+        throw std::invalid_argument("No ProbCut regression for this stage and depth.");
+    }
+    return stage * static_cast<std::size_t>(max_depth - min_depth + 1)
+           + static_cast<std::size_t>(depth - min_depth);
+}
+
+ProbCutParameters fit_probcut_parameters(
+    const std::span<const ProbCutSample> samples,
+    const std::size_t num_stages,
+    const int max_depth,
+    const std::size_t min_samples)
+{
+    auto result = ProbCutParameters{num_stages, max_depth};
+    for (std::size_t stage = 0; stage < num_stages; ++stage) {
+        for (auto depth = ProbCutParameters::min_depth; depth <= max_depth; ++depth) {
+            const auto shallow_depth = ProbCutParameters::get_shallow_depth(depth);
+            auto n = 0.0;
+            auto sum_x = 0.0;
+            auto sum_y = 0.0;
+            auto sum_xx = 0.0;
+            auto sum_xy = 0.0;
+            auto sum_yy = 0.0;
+            for (const auto& sample : samples) {
+                if (result.get_stage(sample.num_discs) != stage
+                    || sample.values.size() <= static_cast<std::size_t>(depth)) {
+                    continue;
+                }
+                const auto shallow_value = sample.values[shallow_depth];
+                const auto deep_value = sample.values[depth];
+                // Searches that see the end of the game do not follow the model.
+                if (std::abs(shallow_value) >= win_score || std::abs(deep_value) >= win_score) {
+                    continue;
+                }
+                const auto x = static_cast<double>(shallow_value);
+                const auto y = static_cast<double>(deep_value);
+                n += 1.0;
+                sum_x += x;
+                sum_y += y;
+                sum_xx += x * x;
+                sum_xy += x * y;
+                sum_yy += y * y;
+            }
+            const auto variance_x = sum_xx - sum_x * sum_x / n;
+            if (n < static_cast<double>(std::max<std::size_t>(min_samples, 3))
+                || variance_x <= 0.0) {
+                continue;
+            }
+            const auto slope = (sum_xy - sum_x * sum_y / n) / variance_x;
+            const auto intercept = (sum_y - slope * sum_x) / n;
+            // Residual sum of squares, expanded so that one pass over the samples suffices.
+            const auto residuals = sum_yy - 2.0 * slope * sum_xy - 2.0 * intercept * sum_y
+                                   + slope * slope * sum_xx + 2.0 * slope * intercept * sum_x
+                                   + n * intercept * intercept;
+            const auto sigma = std::sqrt(std::max(residuals, 0.0) / (n - 2.0));
+            result.set_regression(stage, depth, {slope, intercept, sigma});
+        }
+    }
+    return result;
+}
+
+} // namespace reviser::ai
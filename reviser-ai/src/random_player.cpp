@@ -1,18 +1,26 @@
 #include "random_player.hpp"
 
 #include <cassert>
+#include <iterator>
+#include <random>
 
 namespace reviser::ai {
 
+RandomPlayer::RandomPlayer(const std::string_view name, const PlayerColor pc)
+    : Player{name, pc}
+    , rng{(std::uint64_t{std::random_device{}()} << 32) | std::random_device{}()}
+{}
+
 auto RandomPlayer::pick_move(const BasicBoard& board) const -> Position
 {
-    const auto moves = board.find_valid_moves(get_color());
+    return pick_move_from(board.find_valid_moves(get_color()));
+}
 
-    std::vector<Position> out{};
-    std::ranges::sample(moves, std::back_inserter(out), 1, make_rng());
+auto RandomPlayer::pick_move_from(const PositionSet moves) const -> Position
+{
+    assert(!moves.empty());
 
-    assert(!out.empty());
-    return out[0];
+    return *std::ranges::next(moves.begin(), rng.uniform_index(moves.size()));
 }
 
 } // namespace reviser::ai
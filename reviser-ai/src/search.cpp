@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "search.hpp"
+
+#include <format>
+
+namespace reviser::ai {
+
+double SearchStatistics::get_nodes_per_second() const
+{
+    const auto seconds = std::chrono::duration<double>{elapsed_time}.count();
+    return seconds > 0.0 ? static_cast<double>(nodes) / seconds : 0.0;
+}
+
+std::string SearchStatistics::to_string() const
+{
+    return std::format(
+        "depth {}, {} nodes in {:.3f}s ({:.0f} nodes/s)",
+        completed_depth,
+        nodes,
+        std::chrono::duration<double>{elapsed_time}.count(),
+        get_nodes_per_second());
+}
+
+SearchStatistics& SearchStatistics::operator+=(const SearchStatistics& other)
+{
+    nodes += other.nodes;
+    elapsed_time += other.elapsed_time;
+    completed_depth = std::max(completed_depth, other.completed_depth);
+    return *this;
+}
+
+double SearchTotals::get_average_depth() const
+{
+    return num_searches > 0 ? static_cast<double>(total_depth) / static_cast<double>(num_searches)
+                            : 0.0;
+}
+
+double SearchTotals::get_average_nodes() const
+{
+    return num_searches > 0 ? static_cast<double>(nodes) / static_cast<double>(num_searches)
+                            : 0.0;
+}
+
+std::string SearchTotals::to_string() const
+{
+    return std::format(
+        "{} searches, average depth {:.2f}, {:.0f} nodes and {:.3f}s per search",
+        num_searches,
+        get_average_depth(),
+        get_average_nodes(),
+        num_searches > 0 ? std::chrono::duration<double>{elapsed_time}.count()
+                               / static_cast<double>(num_searches)
+                         : 0.0);
+}
+
+void SearchTotals::add(const SearchStatistics& statistics)
+{
+    ++num_searches;
+    nodes += statistics.nodes;
+    total_depth += static_cast<std::uint64_t>(statistics.completed_depth);
+    elapsed_time += statistics.elapsed_time;
+}
+
+SearchTotals& SearchTotals::operator+=(const SearchTotals& other)
+{
+    num_searches += other.num_searches;
+    nodes += other.nodes;
+    total_depth += other.total_depth;
+    elapsed_time += other.elapsed_time;
+    return *this;
+}
+
+} // namespace reviser::ai
@@ -0,0 +1,135 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "transposition_table.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace reviser::ai {
+
+namespace {
+
+// Layout of the packed data word, from the least significant bit:
+// 32 bits score, 8 bits depth, 2 bits bound + 1 (so that no valid entry packs
+// to zero), 7 bits move (64 for none), 8 bits generation.
+constexpr int depth_shift{32};
+constexpr int bound_shift{40};
+constexpr int move_shift{42};
+constexpr int generation_shift{49};
+constexpr std::uint64_t no_move{64};
+
+std::size_t compute_num_buckets(const std::size_t size_in_bytes, const std::size_t bucket_size)
+{
+    return std::max(std::bit_floor(size_in_bytes / bucket_size), std::size_t{1});
+}
+
+} // namespace
+
+TranspositionTable::TranspositionTable(const std::size_t size_in_mb)
+    : num_buckets{compute_num_buckets(size_in_mb * 1024 * 1024, sizeof(Bucket))}
+    , buckets{std::make_unique<Bucket[]>(num_buckets)}
+{}
+
+std::optional<TranspositionEntry> TranspositionTable::probe(const ZobristHash hash) const
+{
+    for (const auto& slot : bucket_for(hash).slots) {
+        const auto data = slot.data.load(std::memory_order_relaxed);
+        const auto key_xor_data = slot.key_xor_data.load(std::memory_order_relaxed);
+        if (data != 0 && (key_xor_data ^ data) == hash) {
+            return unpack(data);
+        }
+    }
+    return std::nullopt;
+}
+
+void TranspositionTable::store(const ZobristHash hash, const TranspositionEntry& entry)
+{
+    const auto current_generation = generation.load(std::memory_order_relaxed);
+    auto& bucket = bucket_for(hash);
+
+    Slot* replaced_slot = nullptr;
+    auto lowest_value = std::numeric_limits<int>::max();
+    for (auto& slot : bucket.slots) {
+        const auto data = slot.data.load(std::memory_order_relaxed);
+        const auto key_xor_data = slot.key_xor_data.load(std::memory_order_relaxed);
+        if (data == 0 || (key_xor_data ^ data) == hash) {
+            replaced_slot = &slot;
+            break;
+        }
+        // Entries of earlier searches are replaced before entries of the current
+        // search; within a search shallower entries are replaced first.
+        const auto is_current = generation_of(data) == current_generation;
+        const auto value = depth_of(data) + (is_current ? 256 : 0);
+        if (value < lowest_value) {
+            lowest_value = value;
+            replaced_slot = &slot;
+        }
+    }
+
+    const auto data = pack(entry, current_generation);
+    replaced_slot->key_xor_data.store(hash ^ data, std::memory_order_relaxed);
+    replaced_slot->data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::new_search() { generation.fetch_add(1, std::memory_order_relaxed); }
+
+void TranspositionTable::clear()
+{
+    for (std::size_t i = 0; i < num_buckets; ++i) {
+        for (auto& slot : buckets[i].slots) {
+            slot.key_xor_data.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation.store(0, std::memory_order_relaxed);
+}
+
+std::size_t TranspositionTable::get_num_entries() const
+{
+    return num_buckets * slots_per_bucket;
+}
+
+std::size_t TranspositionTable::get_size_in_bytes() const
+{
+    return num_buckets * sizeof(Bucket);
+}
+
+TranspositionTable::Bucket& TranspositionTable::bucket_for(const ZobristHash hash) const
+{
+    return buckets[hash & (num_buckets - 1)];
+}
+
+std::uint64_t
+TranspositionTable::pack(const TranspositionEntry& entry, const std::uint8_t generation)
+{
+    const auto score = static_cast<std::uint32_t>(entry.score);
+    const auto depth = static_cast<std::uint64_t>(std::clamp(entry.depth, 0, 255));
+    const auto bound = static_cast<std::uint64_t>(entry.bound) + 1;
+    const auto move = entry.best_move ? entry.best_move->to_linear_index() : no_move;
+    return score | depth << depth_shift | bound << bound_shift | move << move_shift
+           | std::uint64_t{generation} << generation_shift;
+}
+
+TranspositionEntry TranspositionTable::unpack(const std::uint64_t data)
+{
+    const auto move = (data >> move_shift) & 0x7f;
+    return {
+        static_cast<std::int32_t>(static_cast<std::uint32_t>(data)),
+        depth_of(data),
+        static_cast<Bound>(((data >> bound_shift) & 0x3) - 1),
+        move == no_move ? std::nullopt
+                        : std::optional{Position::from_linear_index(move)}};
+}
+
+int TranspositionTable::depth_of(const std::uint64_t data)
+{
+    return static_cast<int>((data >> depth_shift) & 0xff);
+}
+
+std::uint8_t TranspositionTable::generation_of(const std::uint64_t data)
+{
+    return static_cast<std::uint8_t>(data >> generation_shift);
+}
+
+} // namespace reviser::ai
@@ -0,0 +1,180 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_ARENA_ARENA_HPP
+#define REVISER_ARENA_ARENA_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "board.hpp"
+#include "default_game.hpp"
+#include "game.hpp"
+#include "game_result.hpp"
+#include "notifiers.hpp"
+#include "pattern_evaluator.hpp"
+#include "player.hpp"
+#include "probcut.hpp"
+#include "search.hpp"
+
+namespace reviser_arena {
+
+// Creates a fresh player. Every worker thread calls the factories to obtain its own
+// players, so factories must not hand out shared instances.
+using PlayerFactory = std::function<std::shared_ptr<reviser::Player>()>;
+
+struct ArenaConfig
+{
+    std::size_t num_games{100};
+    std::size_t num_threads{std::max(std::thread::hardware_concurrency(), 1u)};
+    // Plies at the start of each game that are played at random. Both games of a pair
+    // start with the same moves, so that each player plays both sides of an opening.
+    int num_random_moves{};
+    std::uint64_t seed{};
+};
+
+// Plays `num_random_moves` pseudo-random plies at the start of a game and asks the
+// wrapped player for all later moves. The moves depend only on `opening_seed` and
+// the number of discs, so that players with the same seed play the same opening.
+class RandomOpeningPlayer final : public reviser::Player
+{
+public:
+    RandomOpeningPlayer(
+        std::shared_ptr<reviser::Player> player,
+        int num_random_moves,
+        const std::uint64_t& opening_seed);
+
+    void new_game() override { player->new_game(); }
+
+    [[nodiscard]] reviser::Position pick_move(const reviser::BasicBoard& board) const override;
+
+    void game_over(const reviser::GameResult& result) override { player->game_over(result); }
+
+    [[nodiscard]] const reviser::Player& get_player() const { return *player; }
+
+private:
+    std::shared_ptr<reviser::Player> player;
+    int num_random_moves;
+    const std::uint64_t& opening_seed;
+};
+
+// Results of a match, from the point of view of the first player.
+struct ArenaResult
+{
+    std::size_t wins{};
+    std::size_t draws{};
+    std::size_t losses{};
+    std::int64_t total_disc_difference{};
+    std::chrono::nanoseconds elapsed_time{};
+    // The searches of players that implement `SearchTotalsSource`.
+    reviser::ai::SearchTotals first_player_search{};
+    reviser::ai::SearchTotals second_player_search{};
+
+    [[nodiscard]] std::size_t get_num_games() const { return wins + draws + losses; }
+    [[nodiscard]] double get_average_disc_difference() const;
+    [[nodiscard]] double get_games_per_second() const;
+    [[nodiscard]] std::string to_string() const;
+
+    void record_game(const reviser::GameResult& result, const reviser::Player& first_player);
+
+    // Adds the search totals of both players, if they have any.
+    void record_search_totals(
+        const reviser::Player& first_player, const reviser::Player& second_player);
+
+    // Compares the searches of both players: average depths and nodes per move, for
+    // A/B matches between a search and a variant of it.
+    [[nodiscard]] std::string to_search_comparison_string() const;
+
+    ArenaResult& operator+=(const ArenaResult& other);
+};
+
+// Settings shared by all players of a match.
+struct PlayerOptions
+{
+    // Used by `pattern` and `probcut` players.
+    std::shared_ptr<const reviser::ai::PatternWeights> pattern_weights{
+        reviser::ai::PatternWeights::get_default()};
+    // Used by `probcut` players.
+    std::shared_ptr<const reviser::ai::ProbCutParameters> probcut_parameters{
+        reviser::ai::ProbCutParameters::get_default()};
+    // If set, searches and MCTS players stop after this time. Players without an
+    // explicit depth or number of playouts are then limited by time only.
+    std::chrono::milliseconds move_time{std::chrono::milliseconds::max()};
+};
+
+// Creates a factory for the player described by `spec`: "random", "search",
+// "search:<depth>", "pattern", "pattern:<depth>", "probcut", "probcut:<depth>",
+// "mcts", "mcts:<playouts>", "smp", "smp:<depth>" or "smp:<depth>:<threads>".
+// Throws `std::invalid_argument` for unknown specs.
+[[nodiscard]] PlayerFactory
+make_player_factory(std::string_view spec, const PlayerOptions& options = {});
+
+// Plays `config.num_games` games between the players created by the two factories
+// on a pool of worker threads. Each worker owns its players and its game; the first
+// player plays dark in even-numbered games and light in odd-numbered ones.
+template <reviser::BoardType BoardT>
+[[nodiscard]] ArenaResult run_arena(
+    const PlayerFactory& make_first_player,
+    const PlayerFactory& make_second_player,
+    const ArenaConfig& config)
+{
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto num_threads = std::clamp<std::size_t>(config.num_threads, 1, config.num_games);
+    auto next_game = std::atomic<std::size_t>{0};
+    auto worker_results = std::vector<ArenaResult>(num_threads);
+
+    {
+        auto workers = std::vector<std::jthread>{};
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            workers.emplace_back([&, &worker_result = worker_results[i]] {
+                const auto first_player = make_first_player();
+                const auto second_player = make_second_player();
+                auto opening_seed = std::uint64_t{};
+                const auto wrap = [&](const std::shared_ptr<reviser::Player>& player)
+                    -> std::shared_ptr<reviser::Player> {
+                    if (config.num_random_moves == 0) {
+                        return player;
+                    }
+                    return std::make_shared<RandomOpeningPlayer>(
+                        player, config.num_random_moves, opening_seed);
+                };
+                const auto first_game_player = wrap(first_player);
+                auto game = reviser::DefaultGame<BoardT>{
+                    first_game_player,
+                    wrap(second_player),
+                    std::make_unique<reviser::NullNotifier>()};
+                auto first_player_is_dark = true;
+                for (auto game_index = next_game++; game_index < config.num_games;
+                     game_index = next_game++) {
+                    const auto should_be_dark = game_index % 2 == 0;
+                    opening_seed = config.seed + game_index / 2;
+                    game.new_game(should_be_dark != first_player_is_dark);
+                    first_player_is_dark = should_be_dark;
+                    game.run_game_loop();
+                    worker_result.record_game(*game.get_result(), *first_game_player);
+                }
+                worker_result.record_search_totals(*first_player, *second_player);
+            });
+        }
+    }
+
+    auto result = ArenaResult{};
+    for (const auto& worker_result : worker_results) {
+        result += worker_result;
+    }
+    result.elapsed_time = std::chrono::steady_clock::now() - start_time;
+    return result;
+}
+
+} // namespace reviser_arena
+
+#endif // REVISER_ARENA_ARENA_HPP
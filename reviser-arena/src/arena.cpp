@@ -0,0 +1,248 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "arena.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "bit_board.hpp"
+#include "lazy_smp_player.hpp"
+#include "mcts_player.hpp"
+#include "pattern_evaluator.hpp"
+#include "random.hpp"
+#include "random_player.hpp"
+#include "search_player.hpp"
+
+namespace reviser_arena {
+
+using reviser::BasicBoard;
+using reviser::BitBoard;
+using reviser::DecisiveGameResult;
+using reviser::GameResult;
+using reviser::Player;
+using reviser::PlayerColor;
+using reviser::Position;
+using reviser::ai::LazySmpPlayer;
+using reviser::ai::MctsLimits;
+using reviser::ai::MctsPlayer;
+using reviser::ai::PatternEvaluator;
+using reviser::ai::PatternWeights;
+using reviser::ai::RandomPlayer;
+using reviser::ai::SearchLimits;
+using reviser::ai::SearchPlayer;
+using reviser::ai::SearchTotalsSource;
+
+RandomOpeningPlayer::RandomOpeningPlayer(
+    std::shared_ptr<Player> player, const int num_random_moves, const std::uint64_t& opening_seed)
+    : player{std::move(player)}
+    , num_random_moves{num_random_moves}
+    , opening_seed{opening_seed}
+{
+    if (this->player == nullptr || num_random_moves < 0) {
+        throw std::invalid_argument("Must provide a valid player and number of moves.");
+    }
+    set_name(this->player->get_name());
+    set_color(this->player->get_color());
+}
+
+Position RandomOpeningPlayer::pick_move(const BasicBoard& board) const
+{
+    // Colors are assigned to this player, not to the wrapped one.
+    player->set_color(get_color());
+    const auto score = board.compute_score();
+    const auto num_discs = 64 - score.get_num_empty_fields();
+    if (num_discs >= 4 + num_random_moves) {
+        return player->pick_move(board);
+    }
+    const auto moves = board.find_valid_moves(get_color());
+    auto state = opening_seed ^ static_cast<std::uint64_t>(num_discs);
+    auto it = moves.begin();
+    std::advance(it, reviser::next_splitmix64(state) % moves.size());
+    return *it;
+}
+
+double ArenaResult::get_average_disc_difference() const
+{
+    const auto num_games = get_num_games();
+    return num_games > 0 ? static_cast<double>(total_disc_difference)
+                               / static_cast<double>(num_games)
+                         : 0.0;
+}
+
+double ArenaResult::get_games_per_second() const
+{
+    const auto seconds = std::chrono::duration<double>{elapsed_time}.count();
+    return seconds > 0.0 ? static_cast<double>(get_num_games()) / seconds : 0.0;
+}
+
+std::string ArenaResult::to_string() const
+{
+    return std::format(
+        "{} games: {} wins, {} draws, {} losses, average disc difference {:+.2f}, "
+        "{:.3f}s ({:.1f} games/s)",
+        get_num_games(),
+        wins,
+        draws,
+        losses,
+        get_average_disc_difference(),
+        std::chrono::duration<double>{elapsed_time}.count(),
+        get_games_per_second());
+}
+
+void ArenaResult::record_game(const GameResult& result, const Player& first_player)
+{
+    if (const auto* decisive_result = dynamic_cast<const DecisiveGameResult*>(&result)) {
+        if (decisive_result->get_winner() == first_player) {
+            ++wins;
+        }
+        else {
+            ++losses;
+        }
+    }
+    else {
+        ++draws;
+    }
+    const auto score = result.get_score();
+    const auto pc = first_player.get_color();
+    total_disc_difference += score.get_num_fields_for(pc)
+                             - score.get_num_fields_for(other_player_color(pc));
+}
+
+void ArenaResult::record_search_totals(const Player& first_player, const Player& second_player)
+{
+    if (const auto* source = dynamic_cast<const SearchTotalsSource*>(&first_player)) {
+        first_player_search += source->get_search_totals();
+    }
+    if (const auto* source = dynamic_cast<const SearchTotalsSource*>(&second_player)) {
+        second_player_search += source->get_search_totals();
+    }
+}
+
+std::string ArenaResult::to_search_comparison_string() const
+{
+    const auto first_nodes = first_player_search.get_average_nodes();
+    const auto second_nodes = second_player_search.get_average_nodes();
+    return std::format(
+        "First player: {}\nSecond player: {}\n"
+        "Depth difference {:+.2f}, node ratio {:.3f}",
+        first_player_search.to_string(),
+        second_player_search.to_string(),
+        first_player_search.get_average_depth() - second_player_search.get_average_depth(),
+        second_nodes > 0.0 ? first_nodes / second_nodes : 0.0);
+}
+
+ArenaResult& ArenaResult::operator+=(const ArenaResult& other)
+{
+    wins += other.wins;
+    draws += other.draws;
+    losses += other.losses;
+    total_disc_difference += other.total_disc_difference;
+    first_player_search += other.first_player_search;
+    second_player_search += other.second_player_search;
+    elapsed_time = std::max(elapsed_time, other.elapsed_time);
+    return *this;
+}
+
+PlayerFactory make_player_factory(const std::string_view spec, const PlayerOptions& options)
+{
+    const auto has_move_time = options.move_time != std::chrono::milliseconds::max();
+    const auto separator = spec.find(':');
+    const auto type = spec.substr(0, separator);
+    const auto argument = separator == std::string_view::npos
+                              ? std::string_view{}
+                              : spec.substr(separator + 1);
+
+    if (type == "random" && argument.empty()) {
+        return [] { return std::make_shared<RandomPlayer>("Random player"); };
+    }
+    if (type == "mcts") {
+        auto limits = MctsLimits{};
+        if (has_move_time) {
+            limits.max_time = options.move_time;
+            limits.max_playouts = std::numeric_limits<std::uint64_t>::max();
+        }
+        if (!argument.empty()) {
+            const auto* argument_end = argument.data() + argument.size();
+            const auto [end, error]
+                = std::from_chars(argument.data(), argument_end, limits.max_playouts);
+            if (error != std::errc{} || end != argument_end || limits.max_playouts < 1) {
+                throw std::invalid_argument(std::format("Invalid number of playouts: {}", argument));
+            }
+        }
+        const auto limit = has_move_time && argument.empty()
+                               ? std::format("{} ms", options.move_time.count())
+                               : std::format("{} playouts", limits.max_playouts);
+        return [limits, limit] {
+            return std::make_shared<MctsPlayer>(std::format("MCTS player ({})", limit), limits);
+        };
+    }
+    if (type == "search" || type == "pattern" || type == "probcut" || type == "smp") {
+        auto limits = SearchLimits{};
+        if (has_move_time) {
+            limits.max_time = options.move_time;
+            limits.max_depth = 60;
+        }
+        auto num_threads = std::size_t{std::max(std::thread::hardware_concurrency(), 1u)};
+        if (!argument.empty()) {
+            const auto* argument_end = argument.data() + argument.size();
+            auto result = std::from_chars(argument.data(), argument_end, limits.max_depth);
+            if (type == "smp" && result.ec == std::errc{} && result.ptr != argument_end
+                && *result.ptr == ':') {
+                result = std::from_chars(result.ptr + 1, argument_end, num_threads);
+            }
+            if (result.ec != std::errc{} || result.ptr != argument_end || limits.max_depth < 1
+                || num_threads < 1) {
+                throw std::invalid_argument(std::format("Invalid search depth: {}", argument));
+            }
+        }
+        const auto limit = has_move_time && argument.empty()
+                               ? std::format("{} ms", options.move_time.count())
+                               : std::format("depth {}", limits.max_depth);
+        if (type == "smp") {
+            return [limits, num_threads, limit] {
+                return std::make_shared<LazySmpPlayer<BitBoard>>(
+                    std::format("Lazy SMP player ({}, {} threads)", limit, num_threads),
+                    limits,
+                    num_threads);
+            };
+        }
+        if (type == "pattern") {
+            return [limits, limit, pattern_weights = options.pattern_weights] {
+                return std::make_shared<SearchPlayer<BitBoard, PatternEvaluator>>(
+                    std::format("Pattern player ({})", limit),
+                    limits,
+                    PlayerColor::dark,
+                    nullptr,
+                    PatternEvaluator{pattern_weights});
+            };
+        }
+        if (type == "probcut") {
+            return [limits,
+                    limit,
+                    pattern_weights = options.pattern_weights,
+                    probcut_parameters = options.probcut_parameters] {
+                auto player = std::make_shared<SearchPlayer<BitBoard, PatternEvaluator>>(
+                    std::format("ProbCut player ({})", limit),
+                    limits,
+                    PlayerColor::dark,
+                    nullptr,
+                    PatternEvaluator{pattern_weights});
+                player->set_probcut_parameters(probcut_parameters);
+                return player;
+            };
+        }
+        return [limits, limit] {
+            return std::make_shared<SearchPlayer<BitBoard>>(
+                std::format("Search player ({})", limit), limits);
+        };
+    }
+    throw std::invalid_argument(std::format("Unknown player: {}", spec));
+}
+
+} // namespace reviser_arena
@@ -0,0 +1,148 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "arena.hpp"
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "pattern_evaluator.hpp"
+#include "probcut.hpp"
+
+using reviser::ArrayBoard;
+using reviser::BitBoard;
+using reviser::ai::PatternWeights;
+using reviser::ai::ProbCutParameters;
+using reviser_arena::ArenaConfig;
+using reviser_arena::ArenaResult;
+using reviser_arena::make_player_factory;
+using reviser_arena::PlayerOptions;
+using reviser_arena::run_arena;
+
+namespace {
+
+constexpr auto usage
+    = "Usage: reviser-arena [--games N] [--threads N] [--board array|bit] [--weights FILE]\n"
+      "                     [--probcut FILE] [--cut-threshold X] [--move-time MS]\n"
+      "                     [--random-moves N] [--seed N] [--ab] FIRST SECOND\n"
+      "Players: random, search, search:<depth>, pattern, pattern:<depth>, probcut,\n"
+      "         probcut:<depth>, mcts, mcts:<playouts>, smp, smp:<depth>,\n"
+      "         smp:<depth>:<threads>\n";
+
+constexpr int ab_random_moves{8};
+
+std::size_t parse_count(const std::string_view arg)
+{
+    auto result = std::size_t{};
+    const auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), result);
+    if (error != std::errc{} || end != arg.data() + arg.size() || result == 0) {
+        throw std::invalid_argument(std::format("Invalid count: {}", arg));
+    }
+    return result;
+}
+
+double parse_threshold(const std::string_view arg)
+{
+    auto result = 0.0;
+    const auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), result);
+    if (error != std::errc{} || end != arg.data() + arg.size() || result < 0.0) {
+        throw std::invalid_argument(std::format("Invalid cut threshold: {}", arg));
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    try {
+        auto config = ArenaConfig{};
+        auto board_type = std::string_view{"bit"};
+        auto options = PlayerOptions{};
+        auto probcut_parameters = *options.probcut_parameters;
+        auto compare_searches = false;
+        auto player_specs = std::vector<std::string_view>{};
+        for (auto i = 1; i < argc; ++i) {
+            const auto arg = std::string_view{argv[i]};
+            const auto has_value = i + 1 < argc;
+            if ((arg == "--games" || arg == "-n") && has_value) {
+                config.num_games = parse_count(argv[++i]);
+            }
+            else if ((arg == "--threads" || arg == "-t") && has_value) {
+                config.num_threads = parse_count(argv[++i]);
+            }
+            else if ((arg == "--board" || arg == "-b") && has_value) {
+                board_type = argv[++i];
+            }
+            else if ((arg == "--weights" || arg == "-w") && has_value) {
+                options.pattern_weights = std::make_shared<const PatternWeights>(
+                    PatternWeights::load(argv[++i]));
+            }
+            else if (arg == "--probcut" && has_value) {
+                const auto threshold = probcut_parameters.get_cut_threshold();
+                probcut_parameters = ProbCutParameters::load(argv[++i]);
+                probcut_parameters.set_cut_threshold(threshold);
+            }
+            else if (arg == "--cut-threshold" && has_value) {
+                probcut_parameters.set_cut_threshold(parse_threshold(argv[++i]));
+            }
+            else if (arg == "--move-time" && has_value) {
+                options.move_time = std::chrono::milliseconds{parse_count(argv[++i])};
+            }
+            else if (arg == "--random-moves" && has_value) {
+                config.num_random_moves = static_cast<int>(parse_count(argv[++i]));
+            }
+            else if (arg == "--seed" && has_value) {
+                config.seed = parse_count(argv[++i]);
+            }
+            else if (arg == "--ab") {
+                // A/B matches compare a search with a variant of it, so they need
+                // varied openings.
+                compare_searches = true;
+                if (config.num_random_moves == 0) {
+                    config.num_random_moves = ab_random_moves;
+                }
+            }
+            else {
+                player_specs.push_back(arg);
+            }
+        }
+        if (player_specs.size() != 2 || (board_type != "array" && board_type != "bit")) {
+            std::fputs(usage, stderr);
+            return 1;
+        }
+
+        options.probcut_parameters
+            = std::make_shared<const ProbCutParameters>(std::move(probcut_parameters));
+        const auto make_first_player = make_player_factory(player_specs[0], options);
+        const auto make_second_player = make_player_factory(player_specs[1], options);
+        std::printf(
+            "%s vs. %s: %zu games on %zu threads, %s board\n",
+            make_first_player()->get_name().c_str(),
+            make_second_player()->get_name().c_str(),
+            config.num_games,
+            config.num_threads,
+            board_type.data());
+
+        const auto result
+            = board_type == "array"
+                  ? run_arena<ArrayBoard>(make_first_player, make_second_player, config)
+                  : run_arena<BitBoard>(make_first_player, make_second_player, config);
+        std::printf("%s\n", result.to_string().c_str());
+        if (compare_searches) {
+            std::printf("%s\n", result.to_search_comparison_string().c_str());
+        }
+    }
+    catch (const std::exception& ex) {
+        std::fprintf(stderr, "An error occurred: %s\n", ex.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_BENCH_BENCHMARK_HPP
+#define REVISER_BENCH_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reviser_bench {
+
+// Keeps the compiler from optimizing away the computation of `value`.
+template <typename T>
+void do_not_optimize(const T& value)
+{
+    [[maybe_unused]] const volatile char sink
+        = *reinterpret_cast<const volatile char*>(&value);
+}
+
+// Runs the benchmarked code `iterations` times and returns the number of operations
+// performed, e.g., the number of positions for which moves were generated.
+using BenchmarkBody = std::function<std::uint64_t(std::uint64_t iterations)>;
+
+struct BenchmarkResult
+{
+    std::string name;
+    std::uint64_t iterations{};
+    std::uint64_t operations{};
+    std::chrono::nanoseconds elapsed_time{};
+
+    [[nodiscard]] double get_nanoseconds_per_operation() const;
+    [[nodiscard]] double get_operations_per_second() const;
+};
+
+// A minimal benchmark harness in the style of Google Benchmark: the number of
+// iterations of each benchmark is increased until a run takes at least `min_time`;
+// the reported result is the median of `repetitions` such runs.
+class BenchmarkRunner
+{
+public:
+    explicit BenchmarkRunner(
+        std::chrono::milliseconds min_time = std::chrono::milliseconds{200},
+        int repetitions = 3)
+        : min_time{min_time}
+        , repetitions{repetitions}
+    {}
+
+    void add(std::string name, BenchmarkBody body);
+
+    // Runs all benchmarks whose name contains `filter` in the order in which they
+    // were added.
+    [[nodiscard]] std::vector<BenchmarkResult> run(std::string_view filter = {}) const;
+
+private:
+    struct Benchmark
+    {
+        std::string name;
+        BenchmarkBody body;
+    };
+
+    std::chrono::milliseconds min_time;
+    int repetitions;
+    std::vector<Benchmark> benchmarks{};
+
+    [[nodiscard]] BenchmarkResult run_benchmark(const Benchmark& benchmark) const;
+};
+
+[[nodiscard]] std::string to_string(const std::vector<BenchmarkResult>& results);
+
+// One benchmark per line, with a fixed key order, so that the output of two commits
+// can be compared with `diff`.
+[[nodiscard]] std::string to_json(const std::vector<BenchmarkResult>& results);
+
+} // namespace reviser_bench
+
+#endif // REVISER_BENCH_BENCHMARK_HPP
@@ -0,0 +1,171 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_BENCH_POSITION_CORPUS_HPP
+#define REVISER_BENCH_POSITION_CORPUS_HPP
+
+#include <array>
+#include <string_view>
+
+#include "common.hpp"
+
+namespace reviser_bench {
+
+struct CorpusPosition
+{
+    reviser::PlayerColor side_to_move;
+    std::string_view board;
+};
+
+// Mid-game positions after 16 to 46 random plies. The corpus is fixed so that
+// benchmark results of different commits can be compared.
+inline constexpr std::array<CorpusPosition, 16> position_corpus{{
+    {reviser::PlayerColor::dark,
+     "| | | | | | | | |\n"
+     "| | | | | | | | |\n"
+     "|*|*|*|*|*| | | |\n"
+     "| | |O|*|*| | | |\n"
+     "| |O|O|*|*| | | |\n"
+     "| | |O|*|*| | | |\n"
+     "| |*|O| |O|O|O| |\n"
+     "| | | | | | | | |"},
+    {reviser::PlayerColor::dark,
+     "| | | | | | | | |\n"
+     "| | |*| | | | | |\n"
+     "| | | |*|O|*| | |\n"
+     "| | | |O|*|O|O|O|\n"
+     "| |O|O|*|O| | |O|\n"
+     "| |O|O|O|O|O|O|O|\n"
+     "| |*| | | | | | |\n"
+     "| | | | | | | | |"},
+    {reviser::PlayerColor::dark,
+     "| | | | | | |*| |\n"
+     "| | | | |O|*|*|*|\n"
+     "| | | | |*|*|*| |\n"
+     "| |O|O|O|O|O| | |\n"
+     "| |*|O|*|O|*| | |\n"
+     "| | | |O|*| | | |\n"
+     "| | | |O|*| | | |\n"
+     "| | |O| |*| | | |"},
+    {reviser::PlayerColor::dark,
+     "| | | | | | | |*|\n"
+     "| | | | |O|*|*| |\n"
+     "| |*| |O|O|O|O|O|\n"
+     "|O|O|O|O|O| | | |\n"
+     "| |O|O|O|O| | | |\n"
+     "| | | |O|O|O|*|*|\n"
+     "| | | | |O| |O| |\n"
+     "| | | | | | | | |"},
+    {reviser::PlayerColor::dark,
+     "| |*| | | | | | |\n"
+     "|O| |*| | | | | |\n"
+     "| |O|O|*|*|*| | |\n"
+     "| | |O|*|*|*| | |\n"
+     "| | |O|O|O|O|*| |\n"
+     "| |*|O|*|*|O|*|*|\n"
+     "| | | | |*|O|O| |\n"
+     "| | | | | | | |O|"},
+    {reviser::PlayerColor::dark,
+     "| | | | | |*| | |\n"
+     "| | | |*|*|*| | |\n"
+     "| | |*|*|*|*| |O|\n"
+     "| |O| |*|*|*|O| |\n"
+     "| | |O|*|*|O|O| |\n"
+     "| |*| |O|O|O|O|*|\n"
+     "|*| | |O|O|*| | |\n"
+     "| | | | | | |*| |"},
+    {reviser::PlayerColor::dark,
+     "| |O|O|O| | | | |\n"
+     "|*|O|O|O| |O| |*|\n"
+     "| |*|O|*| | |O|*|\n"
+     "| |O|*|O|*|O|*|O|\n"
+     "|O|*| |*|O|O| | |\n"
+     "| |*| | |*|O|*| |\n"
+     "| | | | | |O|*| |\n"
+     "| | | | | | | | |"},
+    {reviser::PlayerColor::dark,
+     "| | | | |O| | | |\n"
+     "| | | |O|O| | | |\n"
+     "|O|O|O|O|O|O|O| |\n"
+     "| | |*|O|O|*|*| |\n"
+     "| |*| |*|O|*|*|*|\n"
+     "| | |*|O|*|*| | |\n"
+     "| | | |*|O|*|O| |\n"
+     "| |O|O|O| |O|*| |"},
+    {reviser::PlayerColor::dark,
+     "| | | |O| | | | |\n"
+     "| | |O|*|O| |*| |\n"
+     "|*|*|*|*|*|*| | |\n"
+     "| |*|O|*|O|O|O| |\n"
+     "| | |O|*|O|O|O| |\n"
+     "| | |O|*| |O|O|O|\n"
+     "| |*|O|*| |O| |O|\n"
+     "| |O|O|*| |O| | |"},
+    {reviser::PlayerColor::dark,
+     "|O|*| |O| | | | |\n"
+     "| |O| |O| | | | |\n"
+     "|O|*|O|O|*|*|*|*|\n"
+     "|O|O|*|O|*|*|*|*|\n"
+     "|O| |O|*|*|O|*| |\n"
+     "| |O| |*|*|*|*|*|\n"
+     "| | |*| |*|*| | |\n"
+     "| |*| |*| | | | |"},
+    {reviser::PlayerColor::dark,
+     "| | | | |O| | | |\n"
+     "| |*|O| |O|O|O| |\n"
+     "| | |*|O|O|O|O| |\n"
+     "|O|O|O|*|O|O|O| |\n"
+     "| |*|O|*|O|O|O| |\n"
+     "| | |*|O|*|O|O|O|\n"
+     "| | |O|*|O|O|O| |\n"
+     "| |O| |*|*|*|*| |"},
+    {reviser::PlayerColor::dark,
+     "| |*| |*|O| | | |\n"
+     "|O| |*|O|O|O| | |\n"
+     "|O|O|*|*|O|O|*| |\n"
+     "|O|*|O|O|O|O| | |\n"
+     "|O|*|O|O|O|O| | |\n"
+     "| |*|O|*|O|O|*| |\n"
+     "| |*|*|O|O|O| | |\n"
+     "|O|*|*|*| | | | |"},
+    {reviser::PlayerColor::dark,
+     "|O| |O|*|*|O|O| |\n"
+     "|O|O|*| |*|*| | |\n"
+     "|*|O|O|*|*|*|*|*|\n"
+     "| |O|O|O|*| |*| |\n"
+     "|O| |*|*|O|O|O| |\n"
+     "| | |*|*|*|*|O| |\n"
+     "| | |O|O| |O|O|*|\n"
+     "| | |O|*| |*|O| |"},
+    {reviser::PlayerColor::dark,
+     "|O|O|O|O|O|O|O| |\n"
+     "|O|O| |*|*|O|O|O|\n"
+     "|O|O|*|*|*|*| | |\n"
+     "| | |*|*|O|*|*|*|\n"
+     "| |*|O|O|*|O|*|*|\n"
+     "|*| | |O|O|*|*|*|\n"
+     "| | |O|O|O| |*|*|\n"
+     "| | | |*| | | |*|"},
+    {reviser::PlayerColor::dark,
+     "| | | |O| |O|*| |\n"
+     "| |*|*|*|*|*|O|*|\n"
+     "| |O|O|O|O|*| |O|\n"
+     "|O|O|O|O|*|*|O|*|\n"
+     "| |O|O|O|O|*|*|*|\n"
+     "|*|O|O|O|*|*|*|*|\n"
+     "|*|O|O| |*|O| |*|\n"
+     "| | | |*|O|O| | |"},
+    {reviser::PlayerColor::dark,
+     "| | |*|*|*|*|*| |\n"
+     "|O| | |*|*|*|*|*|\n"
+     "|O| |*|*|*|O|*|O|\n"
+     "|O|*|*|*|O|*| | |\n"
+     "|O|*|*|O|*|O| | |\n"
+     "|O|*|O|O|O|O|O| |\n"
+     "|O|O|O|O|O|O|O|O|\n"
+     "|O|O|O|*| |O| | |"},
+}};
+
+} // namespace reviser_bench
+
+#endif // REVISER_BENCH_POSITION_CORPUS_HPP
@@ -0,0 +1,125 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <format>
+#include <utility>
+
+namespace reviser_bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::uint64_t max_iteration_growth{10};
+
+BenchmarkResult time_iterations(
+    const std::string& name, const BenchmarkBody& body, const std::uint64_t iterations)
+{
+    const auto start_time = Clock::now();
+    const auto operations = body(iterations);
+    return {name, iterations, operations, Clock::now() - start_time};
+}
+
+std::string escape_json(const std::string_view str)
+{
+    auto result = std::string{};
+    for (const auto c : str) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result;
+}
+
+} // namespace
+
+double BenchmarkResult::get_nanoseconds_per_operation() const
+{
+    return operations > 0
+               ? static_cast<double>(elapsed_time.count()) / static_cast<double>(operations)
+               : 0.0;
+}
+
+double BenchmarkResult::get_operations_per_second() const
+{
+    const auto seconds = std::chrono::duration<double>{elapsed_time}.count();
+    return seconds > 0.0 ? static_cast<double>(operations) / seconds : 0.0;
+}
+
+void BenchmarkRunner::add(std::string name, BenchmarkBody body)
+{
+    benchmarks.push_back({std::move(name), std::move(body)});
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::run(const std::string_view filter) const
+{
+    auto results = std::vector<BenchmarkResult>{};
+    for (const auto& benchmark : benchmarks) {
+        if (benchmark.name.find(filter) != std::string::npos) {
+            results.push_back(run_benchmark(benchmark));
+        }
+    }
+    return results;
+}
+
+BenchmarkResult BenchmarkRunner::run_benchmark(const Benchmark& benchmark) const
+{
+    auto iterations = std::uint64_t{1};
+    auto result = time_iterations(benchmark.name, benchmark.body, iterations);
+    while (result.elapsed_time < min_time) {
+        // Aim a little beyond `min_time` to avoid another round of calibration.
+        const auto elapsed = std::max<std::int64_t>(result.elapsed_time.count(), 1);
+        const auto target = std::chrono::nanoseconds{min_time}.count() * 14 / 10;
+        const auto growth = std::clamp<std::uint64_t>(
+            static_cast<std::uint64_t>(target / elapsed), 2, max_iteration_growth);
+        iterations *= growth;
+        result = time_iterations(benchmark.name, benchmark.body, iterations);
+    }
+
+    auto repetition_results = std::vector<BenchmarkResult>{result};
+    for (auto i = 1; i < repetitions; ++i) {
+        repetition_results.push_back(
+            time_iterations(benchmark.name, benchmark.body, iterations));
+    }
+    std::ranges::sort(repetition_results, {}, &BenchmarkResult::get_nanoseconds_per_operation);
+    return repetition_results[repetition_results.size() / 2];
+}
+
+std::string to_string(const std::vector<BenchmarkResult>& results)
+{
+    auto result = std::format(
+        "{:<40} {:>12} {:>14} {:>16}\n", "Benchmark", "Iterations", "ns/op", "ops/s");
+    for (const auto& benchmark : results) {
+        result += std::format(
+            "{:<40} {:>12} {:>14.2f} {:>16.0f}\n",
+            benchmark.name,
+            benchmark.iterations,
+            benchmark.get_nanoseconds_per_operation(),
+            benchmark.get_operations_per_second());
+    }
+    return result;
+}
+
+std::string to_json(const std::vector<BenchmarkResult>& results)
+{
+    auto result = std::string{"{\n  \"benchmarks\": [\n"};
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& benchmark = results[i];
+        result += std::format(
+            "    {{\"name\": \"{}\", \"iterations\": {}, \"operations\": {}, "
+            "\"ns_per_operation\": {:.3f}, \"operations_per_second\": {:.1f}}}{}\n",
+            escape_json(benchmark.name),
+            benchmark.iterations,
+            benchmark.operations,
+            benchmark.get_nanoseconds_per_operation(),
+            benchmark.get_operations_per_second(),
+            i + 1 < results.size() ? "," : "");
+    }
+    result += "  ]\n}\n";
+    return result;
+}
+
+} // namespace reviser_bench
@@ -0,0 +1,549 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "array_board.hpp"
+#include "benchmark.hpp"
+#include "bit_board.hpp"
+#include "board.hpp"
+#include "default_game.hpp"
+#include "endgame_solver.hpp"
+#include "evaluation.hpp"
+#include "game_record.hpp"
+#include "lazy_smp_search.hpp"
+#include "mcts_player.hpp"
+#include "opening_book.hpp"
+#include "pattern_evaluator.hpp"
+#include "pattern_training.hpp"
+#include "position_corpus.hpp"
+#include "notifiers.hpp"
+#include "random_player.hpp"
+#include "static_game.hpp"
+
+using reviser::all_board_positions;
+using reviser::ArrayBoard;
+using reviser::BitBoard;
+using reviser::Bits;
+using reviser::BoardReader;
+using reviser::BoardType;
+using reviser::BoardWriter;
+using reviser::DefaultGame;
+using reviser::GameRecord;
+using reviser::GameRecordReader;
+using reviser::GameRecordWriter;
+using reviser::NullNotifier;
+using reviser::PlayerColor;
+using reviser::Position;
+using reviser::StaticGame;
+using reviser::ai::EndgameSolver;
+using reviser::ai::LazySmpSearch;
+using reviser::ai::MctsLimits;
+using reviser::ai::MctsSearch;
+using reviser::ai::OpeningBook;
+using reviser::ai::OpeningBookBuilder;
+using reviser::ai::ParallelEndgameSolver;
+using reviser::ai::PatternEvaluator;
+using reviser::ai::TrainingSet;
+using reviser::ai::RandomPlayer;
+using reviser_bench::BenchmarkRunner;
+using reviser_bench::do_not_optimize;
+using reviser_bench::position_corpus;
+
+namespace {
+
+constexpr auto usage
+    = "Usage: reviser-bench [--filter TEXT] [--min-time MS] [--json FILE]\n";
+
+template <BoardType BoardT>
+std::vector<BoardT> read_corpus()
+{
+    auto result = std::vector<BoardT>{};
+    for (const auto& position : position_corpus) {
+        result.push_back(BoardReader<BoardT>::board_from_string(position.board));
+    }
+    return result;
+}
+
+template <BoardType BoardT>
+void add_board_benchmarks(BenchmarkRunner& runner, const std::string_view board_name)
+{
+    const auto boards = std::make_shared<std::vector<BoardT>>(read_corpus<BoardT>());
+    const auto name = [board_name](const std::string_view benchmark_name) {
+        return std::format("{}/{}", board_name, benchmark_name);
+    };
+
+    runner.add(name("find_valid_moves"), [boards](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (std::size_t j = 0; j < boards->size(); ++j) {
+                const auto moves
+                    = (*boards)[j].find_valid_moves(position_corpus[j].side_to_move);
+                do_not_optimize(moves);
+            }
+        }
+        return iterations * boards->size();
+    });
+
+    runner.add(name("is_valid_move"), [boards](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (std::size_t j = 0; j < boards->size(); ++j) {
+                for (const auto pos : all_board_positions()) {
+                    const auto is_valid
+                        = (*boards)[j].is_valid_move(position_corpus[j].side_to_move, pos);
+                    do_not_optimize(is_valid);
+                }
+            }
+        }
+        return iterations * boards->size() * all_board_positions().size();
+    });
+
+    runner.add(name("play_move+undo_move"), [boards](const std::uint64_t iterations) {
+        auto board_copies = *boards;
+        auto num_moves = std::uint64_t{};
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (std::size_t j = 0; j < board_copies.size(); ++j) {
+                auto& board = board_copies[j];
+                const auto pc = position_corpus[j].side_to_move;
+                for (const Position move : board.find_valid_moves(pc)) {
+                    const auto record = board.play_move(pc, move);
+                    do_not_optimize(record);
+                    board.undo_move(record);
+                    ++num_moves;
+                }
+            }
+        }
+        return num_moves;
+    });
+
+    runner.add(name("compute_score"), [boards](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (const auto& board : *boards) {
+                const auto score = board.compute_score();
+                do_not_optimize(score);
+            }
+        }
+        return iterations * boards->size();
+    });
+
+    runner.add(name("canonical_form"), [boards](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (const auto& board : *boards) {
+                const auto canonical = reviser::canonical_form(board);
+                do_not_optimize(canonical.symmetry);
+            }
+        }
+        return iterations * boards->size();
+    });
+
+    runner.add(name("board_from_string"), [](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (const auto& position : position_corpus) {
+                const auto board = BoardReader<BoardT>::board_from_string(position.board);
+                do_not_optimize(board);
+            }
+        }
+        return iterations * position_corpus.size();
+    });
+
+    runner.add(name("board_to_string"), [boards](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (const auto& board : *boards) {
+                const auto board_string = BoardWriter<BoardT>::board_to_string(board);
+                do_not_optimize(board_string);
+            }
+        }
+        return iterations * boards->size();
+    });
+
+    runner.add(name("run_game_loop"), [](const std::uint64_t iterations) {
+        auto game = DefaultGame<BoardT>{
+            std::make_shared<RandomPlayer>("dark", 1),
+            std::make_shared<RandomPlayer>("light", 2),
+            std::make_unique<NullNotifier>()};
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            game.new_game(i % 2 == 1);
+            game.run_game_loop();
+            do_not_optimize(game.get_result());
+        }
+        return iterations;
+    });
+
+    runner.add(name("run_static_game_loop"), [](const std::uint64_t iterations) {
+        auto game = StaticGame<BoardT, RandomPlayer, RandomPlayer, NullNotifier>{
+            std::make_shared<RandomPlayer>("dark", 1),
+            std::make_shared<RandomPlayer>("light", 2),
+            std::make_unique<NullNotifier>()};
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            game.new_game(i % 2 == 1);
+            game.run_game_loop();
+            do_not_optimize(game.get_result());
+        }
+        return iterations;
+    });
+}
+
+// Records of random games, together with their total number of moves.
+std::pair<std::vector<GameRecord>, std::uint64_t> make_game_records()
+{
+    auto stream = std::stringstream{};
+    auto game = StaticGame<BitBoard, RandomPlayer, RandomPlayer, GameRecordWriter>{
+        std::make_shared<RandomPlayer>("dark", 1),
+        std::make_shared<RandomPlayer>("light", 2),
+        std::make_unique<GameRecordWriter>(stream)};
+    for (auto i = 0; i < 256; ++i) {
+        game.new_game(i % 2 == 1);
+        game.run_game_loop();
+    }
+
+    auto records = std::vector<GameRecord>{};
+    auto num_moves = std::uint64_t{};
+    auto reader = GameRecordReader{stream};
+    for (auto record = GameRecord{}; reader.read_next(record);) {
+        num_moves += record.moves.size();
+        records.push_back(record);
+    }
+    return {std::move(records), num_moves};
+}
+
+void add_game_record_benchmarks(BenchmarkRunner& runner)
+{
+    using GameRecords = std::pair<std::vector<GameRecord>, std::uint64_t>;
+    const auto game_records = std::make_shared<const GameRecords>(make_game_records());
+
+    // Operations are moves, so that the results show the throughput in moves per second.
+    runner.add("GameRecord/write", [game_records](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            auto stream = std::ostringstream{};
+            auto writer = GameRecordWriter{stream};
+            for (const auto& record : game_records->first) {
+                writer.write(record);
+            }
+            do_not_optimize(stream);
+        }
+        return iterations * game_records->second;
+    });
+
+    runner.add("GameRecord/read", [game_records](const std::uint64_t iterations) {
+        auto stream = std::ostringstream{};
+        auto writer = GameRecordWriter{stream};
+        for (const auto& record : game_records->first) {
+            writer.write(record);
+        }
+        const auto data = stream.str();
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            auto input = std::istringstream{data};
+            auto reader = GameRecordReader{input};
+            for (auto record = GameRecord{}; reader.read_next(record);) {
+                do_not_optimize(record.moves.back());
+            }
+        }
+        return iterations * game_records->second;
+    });
+}
+
+// Positions with `num_empties` empty fields from the first `num_positions` random
+// games, as pairs of the bits of the player to move and of the opponent.
+std::vector<std::pair<Bits, Bits>>
+make_endgame_positions(const std::size_t num_positions, const int num_empties)
+{
+    auto result = std::vector<std::pair<Bits, Bits>>{};
+    for (const auto& record : make_game_records().first) {
+        auto board = BitBoard{};
+        board.initialize();
+        auto pc = PlayerColor::dark;
+        for (const auto move : record.moves) {
+            if (board.compute_score().get_num_empty_fields() == num_empties) {
+                break;
+            }
+            if (move != reviser::game_record_pass) {
+                board.play_move(pc, Position::from_linear_index(move));
+            }
+            pc = other_player_color(pc);
+        }
+        const auto& final_board = board;
+        if (final_board.compute_score().get_num_empty_fields() == num_empties) {
+            result.emplace_back(
+                final_board.get_bits_for(pc), final_board.get_bits_for(other_player_color(pc)));
+        }
+        if (result.size() == num_positions) {
+            break;
+        }
+    }
+    return result;
+}
+
+// Operations are solved positions with 16 empty fields, for the sequential solver and
+// for the parallel solver with doubling numbers of threads up to the number of cores.
+// Every iteration starts with an empty transposition table.
+void add_endgame_benchmarks(BenchmarkRunner& runner)
+{
+    constexpr int num_empties{16};
+    const auto positions = std::make_shared<const std::vector<std::pair<Bits, Bits>>>(
+        make_endgame_positions(4, num_empties));
+
+    runner.add(
+        std::format("EndgameSolver/empties:{}", num_empties),
+        [positions](const std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const auto solver = EndgameSolver{16};
+                for (const auto& [player, opponent] : *positions) {
+                    do_not_optimize(solver.solve(player, opponent).disc_difference);
+                }
+            }
+            return iterations * positions->size();
+        });
+
+    const auto num_cores = std::max(std::thread::hardware_concurrency(), 1u);
+    for (std::size_t num_threads = 1; num_threads <= num_cores; num_threads *= 2) {
+        runner.add(
+            std::format("ParallelEndgameSolver/empties:{}/threads:{}", num_empties, num_threads),
+            [positions, num_threads](const std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    const auto solver = ParallelEndgameSolver{num_threads, 16};
+                    for (const auto& [player, opponent] : *positions) {
+                        do_not_optimize(solver.solve(player, opponent).disc_difference);
+                    }
+                }
+                return iterations * positions->size();
+            });
+    }
+}
+
+void add_training_benchmarks(BenchmarkRunner& runner)
+{
+    const auto records = std::make_shared<const std::vector<GameRecord>>(make_game_records().first);
+
+    // Operations are extracted positions.
+    runner.add("Training/extract_positions", [records](const std::uint64_t iterations) {
+        auto num_positions = std::uint64_t{};
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            auto training_set = TrainingSet{};
+            for (const auto& record : *records) {
+                training_set.add_game(record);
+            }
+            num_positions += training_set.size();
+            do_not_optimize(training_set.get_positions().back());
+        }
+        return num_positions;
+    });
+}
+
+// Operations are playouts from the initial position, for doubling numbers of threads
+// up to the number of cores.
+void add_mcts_benchmarks(BenchmarkRunner& runner)
+{
+    const auto num_cores = std::max(std::thread::hardware_concurrency(), 1u);
+    for (std::size_t num_threads = 1; num_threads <= num_cores; num_threads *= 2) {
+        runner.add(
+            std::format("MctsSearch/playouts/threads:{}", num_threads),
+            [num_threads](const std::uint64_t iterations) {
+                constexpr std::uint64_t playouts_per_search{20'000};
+                auto search = MctsSearch{
+                    MctsLimits{.max_playouts = playouts_per_search, .num_threads = num_threads}};
+                auto board = BitBoard{};
+                board.initialize();
+                const auto& initial_board = board;
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    search.clear();
+                    do_not_optimize(search.search(
+                        initial_board.get_bits_for(PlayerColor::dark),
+                        initial_board.get_bits_for(PlayerColor::light)));
+                }
+                return iterations * playouts_per_search;
+            });
+    }
+}
+
+// For doubling numbers of threads up to the number of cores: the time to search the
+// first positions of the corpus to a fixed depth, with an empty transposition table,
+// and the number of nodes per second of these searches.
+void add_lazy_smp_benchmarks(BenchmarkRunner& runner)
+{
+    constexpr std::size_t num_positions{4};
+    constexpr int depth{7};
+    const auto boards = std::make_shared<std::vector<BitBoard>>(read_corpus<BitBoard>());
+    boards->resize(num_positions);
+
+    const auto num_cores = std::max(std::thread::hardware_concurrency(), 1u);
+    for (std::size_t num_threads = 1; num_threads <= num_cores; num_threads *= 2) {
+        const auto run_searches = [boards, num_threads] {
+            auto search = LazySmpSearch<BitBoard>{
+                reviser::ai::SearchLimits{.max_depth = depth},
+                num_threads,
+                std::make_shared<reviser::ai::TranspositionTable>(8)};
+            auto num_nodes = std::uint64_t{};
+            for (std::size_t i = 0; i < num_positions; ++i) {
+                const auto result = search.search((*boards)[i], position_corpus[i].side_to_move);
+                num_nodes += result.statistics.nodes;
+            }
+            return num_nodes;
+        };
+
+        runner.add(
+            std::format("LazySmpSearch/time_to_depth:{}/threads:{}", depth, num_threads),
+            [run_searches](const std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    do_not_optimize(run_searches());
+                }
+                return iterations * num_positions;
+            });
+
+        runner.add(
+            std::format("LazySmpSearch/nodes/threads:{}", num_threads),
+            [run_searches](const std::uint64_t iterations) {
+                auto num_nodes = std::uint64_t{};
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    num_nodes += run_searches();
+                }
+                return num_nodes;
+            });
+    }
+}
+
+void add_opening_book_benchmarks(BenchmarkRunner& runner)
+{
+    // A book with the first 20 moves of random games, queried with the positions
+    // of these games.
+    auto builder = OpeningBookBuilder{};
+    auto positions = std::vector<std::pair<BitBoard, PlayerColor>>{};
+    for (const auto& record : make_game_records().first) {
+        builder.add_game(record, 20);
+        auto board = BitBoard{};
+        board.initialize();
+        auto pc = PlayerColor::dark;
+        for (std::size_t i = 0; i < 20 && i < record.moves.size(); ++i) {
+            positions.emplace_back(board, pc);
+            if (record.moves[i] != reviser::game_record_pass) {
+                board.play_move(pc, Position::from_linear_index(record.moves[i]));
+            }
+            pc = reviser::other_player_color(pc);
+        }
+    }
+    auto out = std::ostringstream{};
+    builder.write(out);
+    const auto data = std::make_shared<const std::string>(out.str());
+    const auto book = std::make_shared<const OpeningBook>(std::span{
+        reinterpret_cast<const std::uint8_t*>(data->data()), data->size()});
+    const auto queries = std::make_shared<const decltype(positions)>(std::move(positions));
+
+    runner.add("OpeningBook/find_move", [data, book, queries](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (const auto& [board, pc] : *queries) {
+                do_not_optimize(book->find_move(board, pc));
+            }
+        }
+        return iterations * queries->size();
+    });
+}
+
+void add_evaluation_benchmarks(BenchmarkRunner& runner)
+{
+    const auto boards = std::make_shared<std::vector<BitBoard>>(read_corpus<BitBoard>());
+
+    runner.add("Evaluation/evaluate_position", [boards](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (std::size_t j = 0; j < boards->size(); ++j) {
+                do_not_optimize(reviser::ai::evaluate_position(
+                    (*boards)[j], position_corpus[j].side_to_move));
+            }
+        }
+        return iterations * boards->size();
+    });
+
+    // Each operation plays a move, evaluates the new position and takes the move
+    // back, as in the leaves of the search.
+    runner.add("Evaluation/pattern_play+evaluate+undo", [boards](const std::uint64_t iterations) {
+        auto board_copies = *boards;
+        auto evaluators = std::vector<PatternEvaluator>(board_copies.size());
+        for (std::size_t j = 0; j < board_copies.size(); ++j) {
+            evaluators[j].set_board(board_copies[j]);
+        }
+        auto num_moves = std::uint64_t{};
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            for (std::size_t j = 0; j < board_copies.size(); ++j) {
+                auto& board = board_copies[j];
+                auto& evaluator = evaluators[j];
+                const auto pc = position_corpus[j].side_to_move;
+                for (const Position move : board.find_valid_moves(pc)) {
+                    const auto record = board.play_move(pc, move);
+                    evaluator.play_move(record);
+                    do_not_optimize(evaluator.evaluate(board, reviser::other_player_color(pc)));
+                    evaluator.undo_move(record);
+                    board.undo_move(record);
+                    ++num_moves;
+                }
+            }
+        }
+        return num_moves;
+    });
+}
+
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    auto filter = std::string_view{};
+    auto min_time_ms = 200;
+    auto json_file = std::string{};
+    for (auto i = 1; i < argc; ++i) {
+        const auto arg = std::string_view{argv[i]};
+        const auto has_value = i + 1 < argc;
+        if ((arg == "--filter" || arg == "-f") && has_value) {
+            filter = argv[++i];
+        }
+        else if (arg == "--min-time" && has_value) {
+            const auto value = std::string_view{argv[++i]};
+            const auto [end, error]
+                = std::from_chars(value.data(), value.data() + value.size(), min_time_ms);
+            if (error != std::errc{} || end != value.data() + value.size() || min_time_ms < 1) {
+                std::fputs(usage, stderr);
+                return 1;
+            }
+        }
+        else if (arg == "--json" && has_value) {
+            json_file = argv[++i];
+        }
+        else {
+            std::fputs(usage, stderr);
+            return 1;
+        }
+    }
+
+    auto runner = BenchmarkRunner{std::chrono::milliseconds{min_time_ms}};
+    add_board_benchmarks<ArrayBoard>(runner, "ArrayBoard");
+    add_board_benchmarks<BitBoard>(runner, "BitBoard");
+    add_game_record_benchmarks(runner);
+    add_opening_book_benchmarks(runner);
+    add_evaluation_benchmarks(runner);
+    add_training_benchmarks(runner);
+    add_mcts_benchmarks(runner);
+    add_lazy_smp_benchmarks(runner);
+    add_endgame_benchmarks(runner);
+
+    const auto results = runner.run(filter);
+    std::fputs(reviser_bench::to_string(results).c_str(), stdout);
+    if (json_file == "-") {
+        std::fputs(reviser_bench::to_json(results).c_str(), stdout);
+    }
+    else if (!json_file.empty()) {
+        auto out = std::ofstream{json_file};
+        out << reviser_bench::to_json(results);
+        if (!out) {
+            std::fprintf(stderr, "Could not write %s\n", json_file.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
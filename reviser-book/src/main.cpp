@@ -0,0 +1,117 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "game_record.hpp"
+#include "opening_book.hpp"
+#include "wthor.hpp"
+
+using reviser::GameRecord;
+using reviser::GameRecordReader;
+using reviser::WthorDatabase;
+using reviser::ai::OpeningBookBuilder;
+
+namespace {
+
+constexpr auto usage
+    = "Usage: reviser-book [--moves N] [--output FILE] INPUT...\n"
+      "Inputs ending in .wtb are read as WTHOR databases, all others as game records.\n";
+
+bool is_wthor_file(const std::filesystem::path& path)
+{
+    auto extension = path.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](const unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return extension == ".wtb";
+}
+
+// Adds all games in `path` to `builder` and returns their number.
+std::size_t add_games(
+    OpeningBookBuilder& builder, const std::filesystem::path& path, const std::size_t max_num_moves)
+{
+    auto num_games = std::size_t{0};
+    if (is_wthor_file(path)) {
+        const auto database = WthorDatabase{path};
+        for (const auto game : database.get_games()) {
+            builder.add_game(game, max_num_moves);
+            ++num_games;
+        }
+    }
+    else {
+        auto in = std::ifstream{path, std::ios::binary};
+        if (!in) {
+            throw std::invalid_argument("Could not open " + path.string() + ".");
+        }
+        auto reader = GameRecordReader{in};
+        for (auto record = GameRecord{}; reader.read_next(record);) {
+            builder.add_game(record, max_num_moves);
+            ++num_games;
+        }
+    }
+    return num_games;
+}
+
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    auto max_num_moves = std::size_t{20};
+    auto output = std::filesystem::path{"book.bin"};
+    auto inputs = std::vector<std::filesystem::path>{};
+    for (auto i = 1; i < argc; ++i) {
+        const auto arg = std::string_view{argv[i]};
+        if ((arg == "--moves" || arg == "-m") && i + 1 < argc) {
+            const auto value = std::string_view{argv[++i]};
+            const auto [end, error]
+                = std::from_chars(value.data(), value.data() + value.size(), max_num_moves);
+            if (error != std::errc{} || end != value.data() + value.size()) {
+                std::fputs(usage, stderr);
+                return 1;
+            }
+        }
+        else if ((arg == "--output" || arg == "-o") && i + 1 < argc) {
+            output = argv[++i];
+        }
+        else if (!arg.starts_with("-")) {
+            inputs.emplace_back(arg);
+        }
+        else {
+            std::fputs(usage, stderr);
+            return 1;
+        }
+    }
+    if (inputs.empty()) {
+        std::fputs(usage, stderr);
+        return 1;
+    }
+
+    try {
+        auto builder = OpeningBookBuilder{};
+        auto num_games = std::size_t{0};
+        for (const auto& input : inputs) {
+            num_games += add_games(builder, input, max_num_moves);
+        }
+        builder.write(output);
+        std::printf(
+            "Wrote %zu positions from %zu games to %s\n",
+            builder.get_num_positions(),
+            num_games,
+            output.string().c_str());
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -2,8 +2,8 @@
 
 #include "simple_command_line_player.hpp"
 
-#include <algorithm>
 #include <format>
+#include <iostream>
 
 #include "array_board.hpp"
 #include "position.hpp"
@@ -19,11 +19,8 @@ namespace reviser_cli {
 
     std::vector<reviser::Position>
     SimpleCommandLinePlayer::compute_possible_moves(const reviser::BasicBoard &board) const {
-        auto move_set = board.find_valid_moves(get_color());
-        auto moves = std::vector<reviser::Position>{};
-        moves.insert(end(moves), begin(move_set), end(move_set));
-        std::ranges::sort(moves);
-        return moves;
+        const auto move_set = board.find_valid_moves(get_color());
+        return {move_set.begin(), move_set.end()};
     }
 
     void SimpleCommandLinePlayer::print_possible_move(
@@ -5,42 +5,52 @@
 #define REVISER_LIB_ARRAY_BOARD_HPP
 
 #include <array>
-#include <set>
 #include <string>
 #include <vector>
 
 #include "board.hpp"
 #include "common.hpp"
 #include "position.hpp"
+#include "position_set.hpp"
+#include "rays.hpp"
+#include "symmetry.hpp"
+#include "zobrist.hpp"
 
 namespace reviser {
 
     class ArrayBoard final : public BasicBoard {
     private:
         std::array<Field, 64> fields{};
+        // Number of fields for each value of `Field`, kept up to date by every write.
+        std::array<int_fast8_t, 3> field_counts{64, 0, 0};
+        ZobristHash hash{};
 
     public:
-        using iterator = decltype(fields)::iterator;
+        // Fields can only be modified through the board so that the counts stay valid.
+        using iterator = decltype(fields)::const_iterator;
         using const_iterator [[maybe_unused]] = decltype(fields)::const_iterator;
-        using Moves = std::set<Position>;
+        using Moves = PositionSet;
         using OrderedMoves [[maybe_unused]] = std::vector<Position>;
-        using Positions = std::set<Position>;
-        using OrderedPositions = std::vector<Position>;
+        using Positions = PositionSet;
 
 
         ArrayBoard() = default;
 
         ArrayBoard(const ArrayBoard &other)
-                : fields{other.fields} {}
+                : fields{other.fields}, field_counts{other.field_counts},
+                  hash{other.hash} {}
 
         ArrayBoard(ArrayBoard &&other) noexcept
-                : fields{other.fields} {}
+                : fields{other.fields}, field_counts{other.field_counts},
+                  hash{other.hash} {}
 
         ArrayBoard &operator=(const ArrayBoard &other) {
             if (this == &other) {
                 return *this;
             }
             fields = other.fields;
+            field_counts = other.field_counts;
+            hash = other.hash;
             return *this;
         }
 
@@ -49,20 +59,24 @@ namespace reviser {
                 return *this;
             }
             fields = other.fields;
+            field_counts = other.field_counts;
+            hash = other.hash;
             return *this;
         }
 
         ~ArrayBoard() override = default;
 
-        iterator begin() { return std::begin(fields); }
+        [[nodiscard]] iterator begin() const { return std::cbegin(fields); }
 
-        iterator end() { return std::end(fields); }
+        [[nodiscard]] iterator end() const { return std::cend(fields); }
 
         static ArrayBoard from_string(std::string_view board_string);
 
-        Field &operator[](Position pos) override;
+        FieldReference<ArrayBoard> operator[](Position pos);
 
-        const Field &operator[](Position pos) const override;
+        Field operator[](Position pos) const override;
+
+        void set_field(Position pos, Field field) override;
 
         [[nodiscard]] std::string to_string() const override;
 
@@ -77,10 +91,17 @@ namespace reviser {
 
         [[nodiscard]] Moves find_valid_moves(PlayerColor pc) const override;
 
-        void play_move(PlayerColor pc, Position pos) override;
+        FlipRecord play_move(PlayerColor pc, Position pos) override;
+
+        void undo_move(FlipRecord record) override;
 
         [[nodiscard]] Score compute_score() const override;
 
+        [[nodiscard]] ZobristHash get_hash(PlayerColor side_to_move) const override;
+
+        // The board with the fields moved by `symmetry`, via a permutation table.
+        [[nodiscard]] ArrayBoard transform(Symmetry symmetry) const;
+
     private:
         template<BoardType Board>
         friend
@@ -90,33 +111,25 @@ namespace reviser {
         friend
         class BoardWriter;
 
-        Field &operator[](std::size_t index);
-
         [[nodiscard]] bool
-        does_move_flip_any_field(PlayerColor pc, Position starting_pos) const;
+        does_move_flip_any_field(Field player_field, std::size_t index) const;
 
-        [[nodiscard]] Positions positions_to_flip_in_direction(
-                PlayerColor pc, Position starting_pos, Direction d) const;
-
-        [[nodiscard]] OrderedPositions
-        occupied_positions_in_direction(Direction d, Position starting_pos) const;
-
-        [[nodiscard]] Positions filter_positions_that_can_be_flipped(
-                PlayerColor pc, const OrderedPositions &non_empty_positions) const;
-
-        [[nodiscard]] std::size_t find_highest_index_for_player_owned_fields(
-                PlayerColor pc, const OrderedPositions &non_empty_positions) const;
+        [[nodiscard]] Positions
+        positions_to_flip_along_ray(Field player_field, const Ray &ray) const;
 
         [[nodiscard]] Positions
-        find_positions_flipped_by_move(PlayerColor pc, Position pos) const;
+        find_positions_flipped_by_move(Field player_field, std::size_t index) const;
+
+        void flip_positions(Field player_field, Positions positions_to_flip);
 
-        void flip_positions(PlayerColor pc, const Positions &positions_to_flip);
+        [[nodiscard]] int_fast8_t &count_of(Field field);
     };
 
     bool operator==(const ArrayBoard &lhs, const ArrayBoard &rhs);
 
     static_assert(BasicBoardType<ArrayBoard>);
     static_assert(BoardType<ArrayBoard>);
+    static_assert(SymmetricBoardType<ArrayBoard>);
 
 } // namespace reviser
 #endif // REVISER_LIB_ARRAY_BOARD_HPP
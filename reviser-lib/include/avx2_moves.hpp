@@ -0,0 +1,23 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_AVX2_MOVES_HPP
+#define REVISER_LIB_AVX2_MOVES_HPP
+
+#include "position_set.hpp"
+
+namespace reviser {
+
+// Whether the processor and the operating system support AVX2, determined once with
+// CPUID. Always false on processors other than x86-64.
+[[nodiscard]] bool has_avx2_support();
+
+// Versions of `find_move_bits()` and `find_flip_bits()` that process four directions
+// in the 64-bit lanes of one AVX2 register, in two passes for the eight directions.
+// They may only be called if `has_avx2_support()` returns true.
+[[nodiscard]] Bits find_move_bits_avx2(Bits player, Bits opponent);
+[[nodiscard]] Bits find_flip_bits_avx2(Bits player, Bits opponent, Bits move);
+
+} // namespace reviser
+
+#endif // REVISER_LIB_AVX2_MOVES_HPP
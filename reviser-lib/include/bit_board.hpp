@@ -0,0 +1,244 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_BIT_BOARD_HPP
+#define REVISER_LIB_BIT_BOARD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "direction.hpp"
+#include "position.hpp"
+#include "position_set.hpp"
+#include "symmetry.hpp"
+#include "zobrist.hpp"
+
+namespace reviser {
+
+constexpr Bits all_fields_bits{~Bits{}};
+constexpr Bits not_column_0_bits{0xfefe'fefe'fefe'fefeULL};
+constexpr Bits not_column_7_bits{0x7f7f'7f7f'7f7f'7f7fULL};
+
+struct BitShift
+{
+    int amount;
+    // Fields that can be reached by the shift without wrapping around a row.
+    Bits mask;
+};
+
+[[nodiscard]] constexpr BitShift bit_shift_for_direction(const Direction d)
+{
+    const int dx = d.get_dx();
+    const int dy = d.get_dy();
+    const auto mask = dx > 0 ? not_column_0_bits
+                      : dx < 0 ? not_column_7_bits
+                               : all_fields_bits;
+    return {dy * board_size + dx, mask};
+}
+
+constexpr std::array<BitShift, 8> bit_shifts{[] {
+    auto result = std::array<BitShift, 8>{};
+    for (auto i = 0u; i < directions.size(); ++i) {
+        result[i] = bit_shift_for_direction(directions[i]);
+    }
+    return result;
+}()};
+
+[[nodiscard]] constexpr Bits shift_bits(const Bits bits, const int amount)
+{
+    return amount >= 0 ? bits << amount : bits >> -amount;
+}
+
+// Kogge-Stone occluded fill: all fields reachable from `generator` by moving in the
+// direction of `s` over fields in `propagator`, including the generator fields.
+[[nodiscard]] constexpr Bits
+occluded_fill(Bits generator, Bits propagator, const BitShift s)
+{
+    propagator &= s.mask;
+    generator |= propagator & shift_bits(generator, s.amount);
+    propagator &= shift_bits(propagator, s.amount);
+    generator |= propagator & shift_bits(generator, 2 * s.amount);
+    propagator &= shift_bits(propagator, 2 * s.amount);
+    generator |= propagator & shift_bits(generator, 4 * s.amount);
+    return generator;
+}
+
+// Combines the results of `f<s>()` for all bit shifts `s` with `|`. Passing the
+// shift as template argument unrolls the loop over all directions so that every
+// shift is by a constant amount.
+template <typename F>
+[[nodiscard]] constexpr Bits combine_bit_shifts(F f)
+{
+    return [&f]<std::size_t... I>(std::index_sequence<I...>) {
+        return (f.template operator()<bit_shifts[I]>() | ...);
+    }(std::make_index_sequence<bit_shifts.size()>{});
+}
+
+[[nodiscard]] constexpr Bits find_move_bits(const Bits player, const Bits opponent)
+{
+    const auto empty = ~(player | opponent);
+    const auto moves = combine_bit_shifts([&]<BitShift s>() {
+        const auto fill = occluded_fill(player, opponent, s);
+        return shift_bits(fill & opponent, s.amount) & s.mask;
+    });
+    return moves & empty;
+}
+
+[[nodiscard]] constexpr Bits
+find_flip_bits(const Bits player, const Bits opponent, const Bits move)
+{
+    return combine_bit_shifts([&]<BitShift s>() {
+        const auto fill = occluded_fill(move, opponent, s);
+        return (shift_bits(fill, s.amount) & s.mask & player) != 0 ? fill & opponent
+                                                                   : Bits{};
+    });
+}
+
+
+class BitBoard final : public BasicBoard
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Field;
+        using difference_type = std::ptrdiff_t;
+        using reference = Field;
+        using pointer = void;
+
+        iterator() = default;
+
+        iterator(const BitBoard* board, const std::size_t index)
+            : board{board}
+            , index{index}
+        {}
+
+        Field operator*() const { return (*board)[Position::from_linear_index(index)]; }
+
+        iterator& operator++()
+        {
+            ++index;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto result = *this;
+            ++index;
+            return result;
+        }
+
+        bool operator==(const iterator& other) const = default;
+
+    private:
+        const BitBoard* board{};
+        std::size_t index{};
+    };
+
+    using const_iterator [[maybe_unused]] = iterator;
+    using Moves = PositionSet;
+    using Positions = PositionSet;
+
+    BitBoard() = default;
+
+    BitBoard(const BitBoard& other)
+        : dark_fields{other.dark_fields}
+        , light_fields{other.light_fields}
+        , hash{other.hash}
+    {}
+
+    BitBoard(BitBoard&& other) noexcept
+        : dark_fields{other.dark_fields}
+        , light_fields{other.light_fields}
+        , hash{other.hash}
+    {}
+
+    BitBoard& operator=(const BitBoard& other)
+    {
+        dark_fields = other.dark_fields;
+        light_fields = other.light_fields;
+        hash = other.hash;
+        return *this;
+    }
+
+    BitBoard& operator=(BitBoard&& other) noexcept
+    {
+        dark_fields = other.dark_fields;
+        light_fields = other.light_fields;
+        hash = other.hash;
+        return *this;
+    }
+
+    ~BitBoard() override = default;
+
+    [[nodiscard]] iterator begin() const { return iterator{this, 0}; }
+
+    [[nodiscard]] iterator end() const { return iterator{this, 64}; }
+
+    static BitBoard from_string(std::string_view board_string);
+
+    FieldReference<BitBoard> operator[](Position pos);
+
+    Field operator[](Position pos) const override;
+
+    void set_field(Position pos, Field field) override;
+
+    [[nodiscard]] std::string to_string() const override;
+
+    void initialize(
+        InitialBoardState initial_state = InitialBoardState::center_square) override;
+
+    [[nodiscard]] bool is_empty(Position pos) const override;
+
+    [[nodiscard]] bool is_occupied(Position pos) const override;
+
+    [[nodiscard]] bool is_valid_move(PlayerColor pc, Position pos) const override;
+
+    [[nodiscard]] Moves find_valid_moves(PlayerColor pc) const override;
+
+    FlipRecord play_move(PlayerColor pc, Position pos) override;
+
+    void undo_move(FlipRecord record) override;
+
+    [[nodiscard]] Score compute_score() const override;
+
+    [[nodiscard]] ZobristHash get_hash(PlayerColor side_to_move) const override;
+
+    // The board with the fields moved by `symmetry`, computed bit-parallel.
+    [[nodiscard]] BitBoard transform(Symmetry symmetry) const;
+
+    [[nodiscard]] Bits get_bits_for(PlayerColor pc) const;
+
+    [[nodiscard]] Bits get_empty_bits() const { return ~(dark_fields | light_fields); }
+
+    [[nodiscard]] Bits find_valid_move_bits(PlayerColor pc) const;
+
+    friend bool operator==(const BitBoard& lhs, const BitBoard& rhs)
+    {
+        return lhs.dark_fields == rhs.dark_fields
+               && lhs.light_fields == rhs.light_fields;
+    }
+
+private:
+    Bits dark_fields{};
+    Bits light_fields{};
+    ZobristHash hash{};
+
+    [[nodiscard]] Bits& get_bits_for(PlayerColor pc);
+
+    [[nodiscard]] Bits find_flip_bits_for_move(PlayerColor pc, Bits move) const;
+};
+
+static_assert(BasicBoardType<BitBoard>);
+static_assert(BoardType<BitBoard>);
+static_assert(SymmetricBoardType<BitBoard>);
+
+} // namespace reviser
+#endif // REVISER_LIB_BIT_BOARD_HPP
@@ -9,14 +9,16 @@
 #include <cassert>
 #include <concepts>
 #include <iterator>
-#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common.hpp"
 #include "position.hpp"
+#include "position_set.hpp"
+#include "zobrist.hpp"
 
 namespace reviser {
 
@@ -28,7 +30,30 @@ enum class InitialBoardState
     center_square,
 };
 
-[[nodiscard]] const std::vector<Position>& all_board_positions();
+template <std::size_t... Indices>
+[[nodiscard]] constexpr std::array<Position, sizeof...(Indices)>
+make_board_positions(std::index_sequence<Indices...>)
+{
+    return {Position::from_linear_index(Indices)...};
+}
+
+inline constexpr auto board_positions{make_board_positions(std::make_index_sequence<64>{})};
+
+[[nodiscard]] constexpr const std::array<Position, 64>& all_board_positions()
+{
+    return board_positions;
+}
+
+// The information required to take back a move with `undo_move()`. Moves that were
+// rejected by `play_move()` have no flipped positions and are not undone.
+struct FlipRecord
+{
+    Position move;
+    PlayerColor player_color;
+    PositionSet flipped_positions;
+
+    [[nodiscard]] constexpr bool was_played() const { return !flipped_positions.empty(); }
+};
 
 class BasicBoard
 {
@@ -40,13 +65,13 @@ public:
     BasicBoard& operator=(BasicBoard&& other) noexcept = delete;
     virtual ~BasicBoard() = default;
 
-    using Moves = std::set<Position>;
+    using Moves = PositionSet;
     using OrderedMoves = std::vector<Position>;
-    using Positions = std::set<Position>;
+    using Positions = PositionSet;
     using OrderedPositions = std::vector<Position>;
 
-    virtual Field& operator[](Position pos) = 0;
-    virtual const Field& operator[](Position pos) const = 0;
+    virtual Field operator[](Position pos) const = 0;
+    virtual void set_field(Position pos, Field field) = 0;
 
     [[nodiscard]] virtual std::string to_string() const = 0;
 
@@ -61,9 +86,14 @@ public:
 
     [[nodiscard]] virtual Moves find_valid_moves(PlayerColor pc) const = 0;
 
-    virtual void play_move(PlayerColor pc, Position pos) = 0;
+    virtual FlipRecord play_move(PlayerColor pc, Position pos) = 0;
+
+    virtual void undo_move(FlipRecord record) = 0;
 
     [[nodiscard]] virtual Score compute_score() const = 0;
+
+    // Zobrist hash of the position, maintained incrementally by all modifications.
+    [[nodiscard]] virtual ZobristHash get_hash(PlayerColor side_to_move) const = 0;
 };
 
 template <typename BoardT>
@@ -73,11 +103,14 @@ concept BasicBoardType = requires(
     std::string s,
     Position pos,
     InitialBoardState initial_state,
-    PlayerColor pc) {
+    PlayerColor pc,
+    Field field,
+    FlipRecord record) {
     // clang-format off
     typename BoardT::Moves;
-    { b.operator[](pos) } -> std::convertible_to<Field&>;
-    { cb.operator[](pos) } -> std::convertible_to<const Field&>;
+    { b.operator[](pos) } -> std::convertible_to<Field>;
+    { cb.operator[](pos) } -> std::convertible_to<Field>;
+    b.set_field(pos, field);
     { cb.to_string() } -> std::convertible_to<std::string>;
     b.initialize();
     b.initialize(initial_state);
@@ -85,8 +118,10 @@ concept BasicBoardType = requires(
     { b.is_occupied(pos) } -> std::convertible_to<bool>;
     { b.is_valid_move(pc, pos) } -> std::convertible_to<bool>;
     { b.find_valid_moves(pc) } -> std::convertible_to<typename BoardT::Moves>;
-    b.play_move(pc, pos);
+    { b.play_move(pc, pos) } -> std::convertible_to<FlipRecord>;
+    b.undo_move(record);
     { b.compute_score() } -> std::convertible_to<Score>;
+    { cb.get_hash(pc) } -> std::convertible_to<ZobristHash>;
     // clang-format on
 };
 
@@ -106,6 +141,73 @@ concept BoardType = BasicBoardType<BoardT> && requires(BoardT b, std::string s)
 // clang-format on
 
 
+// Returns a copy of `board` with the representation `BoardT`. This is cheap if `board`
+// already is a `BoardT`, otherwise the fields are copied one by one.
+template <BoardType BoardT>
+[[nodiscard]] BoardT copy_board_as(const BasicBoard& board)
+{
+    if constexpr (std::derived_from<BoardT, BasicBoard>) {
+        if (const auto* typed_board = dynamic_cast<const BoardT*>(&board)) {
+            return *typed_board;
+        }
+    }
+    auto result = BoardT{};
+    for (const auto pos : all_board_positions()) {
+        result.set_field(pos, board[pos]);
+    }
+    return result;
+}
+
+
+// Computes the Zobrist hash of `board` from scratch.
+template <BasicBoardType BoardT>
+[[nodiscard]] ZobristHash
+compute_zobrist_hash(const BoardT& board, const PlayerColor side_to_move)
+{
+    auto result = zobrist_side_to_move_key(side_to_move);
+    for (const auto pos : all_board_positions()) {
+        result ^= zobrist_key(board[pos], pos.to_linear_index());
+    }
+    return result;
+}
+
+
+// Assignable reference to a field of a board that does not store its fields as
+// `Field` values. Writes are forwarded to the board's `set_field()`.
+template <typename BoardT>
+class FieldReference
+{
+public:
+    FieldReference(BoardT& board, const Position pos)
+        : board{board}
+        , pos{pos}
+    {}
+
+    FieldReference(const FieldReference& other) = default;
+
+    FieldReference& operator=(const FieldReference& other)
+    {
+        return *this = static_cast<Field>(other);
+    }
+
+    FieldReference& operator=(const Field field)
+    {
+        board.set_field(pos, field);
+        return *this;
+    }
+
+    // ReSharper disable once CppNonExplicitConversionOperator
+    operator Field() const // NOLINT(google-explicit-constructor)
+    {
+        return std::as_const(board)[pos];
+    }
+
+private:
+    BoardT& board;
+    Position pos;
+};
+
+
 template <BoardType Board>
 class BoardReader
 {
@@ -116,7 +218,8 @@ public:
         assert(cleaned_string.size() == 64);
         auto result = Board{};
         for (auto i = 0u; i < 64; ++i) {
-            result[i] = convert_char(cleaned_string[i]);
+            result.set_field(
+                Position::from_linear_index(i), convert_char(cleaned_string[i]));
         }
         return result;
     }
@@ -58,7 +58,7 @@ V find_default(const std::map<K, V>& values, K value)
 class Score
 {
 public:
-    Score(
+    constexpr Score(
         const int_fast8_t num_dark_fields,
         const int_fast8_t num_light_fields,
         const int_fast8_t num_empty_fields)
@@ -67,16 +67,18 @@ public:
         , num_empty_fields{num_empty_fields}
     {}
 
-    explicit Score(const std::map<Field, int_fast8_t>& values)
-        : Score{
-            find_default(values, Field::dark),
-            find_default(values, Field::light),
-            find_default(values, Field::empty)}
-    {}
-
-    [[nodiscard]] int_fast8_t get_num_dark_fields() const { return num_dark_fields; }
-    [[nodiscard]] int_fast8_t get_num_light_fields() const { return num_light_fields; }
-    [[nodiscard]] int_fast8_t get_num_empty_fields() const { return num_empty_fields; }
+    [[nodiscard]] constexpr int_fast8_t get_num_dark_fields() const
+    {
+        return num_dark_fields;
+    }
+    [[nodiscard]] constexpr int_fast8_t get_num_light_fields() const
+    {
+        return num_light_fields;
+    }
+    [[nodiscard]] constexpr int_fast8_t get_num_empty_fields() const
+    {
+        return num_empty_fields;
+    }
 
     [[nodiscard]] int_fast8_t get_num_fields_for(PlayerColor pc) const;
     [[nodiscard]] int_fast8_t get_num_fields_for(const Player& player) const;
@@ -39,7 +39,7 @@ public:
     [[nodiscard]] const Notifier& get_notifier() const noexcept { return *notifier; }
 
 private:
-    using Moves = std::set<Position>;
+    using Moves = typename BoardT::Moves;
 
     Players players;
 
@@ -0,0 +1,118 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_GAME_RECORD_HPP
+#define REVISER_LIB_GAME_RECORD_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "game.hpp"
+#include "game_result.hpp"
+#include "position.hpp"
+
+namespace reviser {
+
+// Binary game records. A stream starts with the four bytes "RVGR" and a version byte,
+// followed by records of the form
+//
+//   u16 payload length (little endian)
+//   u8  result type (`GameResultType`)
+//   u64 seed (little endian)
+//   u8  dark discs, u8 light discs, u8 empty fields (the final `Score`)
+//   u8  length + bytes of the dark player's name
+//   u8  length + bytes of the light player's name
+//   one byte per move until the end of the payload: the linear index of the field,
+//   or `game_record_pass` if the player to move had to pass.
+//
+// Games always start from the standard initial position with dark to move.
+inline constexpr std::string_view game_record_magic{"RVGR"};
+inline constexpr std::uint8_t game_record_version{1};
+inline constexpr std::uint8_t game_record_pass{64};
+
+struct GameRecord
+{
+    GameResultType result_type{GameResultType::tie};
+    std::uint64_t seed{};
+    Score score{0, 0, 64};
+    std::string dark_player_name{};
+    std::string light_player_name{};
+    std::vector<std::uint8_t> moves{};
+};
+
+// Writes one record for each finished game to `out`. The records are assembled in
+// memory and written with a single call when the result is noted.
+class GameRecordWriter final : public Notifier
+{
+public:
+    explicit GameRecordWriter(std::ostream& out);
+
+    // The seed that is stored with the next game, e.g., the seed of a random player.
+    void set_seed(std::uint64_t new_seed) noexcept { seed = new_seed; }
+
+    void display_message(std::string_view message) override {}
+    void display_board(const BasicBoard& board) override {}
+    void note_new_game(const Players& players, const BasicBoard& board) override;
+    void note_move(const Player& player, Position pos, const BasicBoard& board) override;
+    void note_result(const GameResult& result) override;
+
+    void write(const GameRecord& record);
+
+    [[nodiscard]] std::uint64_t get_num_games_written() const noexcept
+    {
+        return num_games_written;
+    }
+
+private:
+    std::ostream* out;
+    std::uint64_t seed{};
+    std::uint64_t num_games_written{};
+    GameRecord current_record{};
+    PlayerColor next_color{PlayerColor::dark};
+    std::string buffer{};
+};
+
+// Reads the records written by `GameRecordWriter`. Throws `std::invalid_argument` if
+// the stream does not start with a valid header or contains a truncated record.
+class GameRecordReader
+{
+public:
+    explicit GameRecordReader(std::istream& in);
+
+    // Reads the next record into `record`, reusing its storage. Returns false at the
+    // end of the stream.
+    bool read_next(GameRecord& record);
+
+private:
+    std::istream* in;
+    std::string buffer{};
+};
+
+// Plays the moves of `record` on `board`, starting from the initial position.
+// Throws `std::invalid_argument` if the record contains an invalid move.
+template <BasicBoardType BoardT>
+void replay_game_record(const GameRecord& record, BoardT& board)
+{
+    board.initialize();
+    auto pc = PlayerColor::dark;
+    for (const auto move : record.moves) {
+        if (move != game_record_pass) {
+            if (move > game_record_pass
+                || !board.play_move(pc, Position::from_linear_index(move)).was_played()) {
+                throw std::invalid_argument("Game record contains an invalid move.");
+            }
+        }
+        pc = other_player_color(pc);
+    }
+}
+
+} // namespace reviser
+
+#endif // REVISER_LIB_GAME_RECORD_HPP
@@ -5,6 +5,7 @@
 #ifndef REVISER_LIB_GAME_RESULT_HPP
 #define REVISER_LIB_GAME_RESULT_HPP
 
+#include <cstdint>
 #include <functional>
 #include <string>
 
@@ -16,6 +17,13 @@ class BasicBoard;
 class Player;
 class Score;
 
+enum class GameResultType : std::uint8_t
+{
+    win_by_score,
+    win_by_opponent_mistake,
+    tie,
+};
+
 class GameResult
 {
 public:
@@ -31,6 +39,7 @@ public:
     virtual ~GameResult() = default;
 
     [[nodiscard]] virtual std::string to_string() const = 0;
+    [[nodiscard]] virtual GameResultType get_type() const = 0;
 
     [[nodiscard]] virtual Score get_score() const { return score; }
     [[maybe_unused]] [[nodiscard]] virtual const BasicBoard& get_board() const;
@@ -66,6 +75,10 @@ class WinByScore final : public DecisiveGameResult
 public:
     using DecisiveGameResult::DecisiveGameResult;
     [[nodiscard]] std::string to_string() const override;
+    [[nodiscard]] GameResultType get_type() const override
+    {
+        return GameResultType::win_by_score;
+    }
 };
 
 class WinByOpponentMistake final : public DecisiveGameResult
@@ -73,6 +86,10 @@ class WinByOpponentMistake final : public DecisiveGameResult
 public:
     using DecisiveGameResult::DecisiveGameResult;
     [[nodiscard]] std::string to_string() const override;
+    [[nodiscard]] GameResultType get_type() const override
+    {
+        return GameResultType::win_by_opponent_mistake;
+    }
 };
 
 
@@ -93,6 +110,7 @@ public:
     [[nodiscard]] const Player& get_light_player() const { return light_player; }
 
     [[nodiscard]] std::string to_string() const override;
+    [[nodiscard]] GameResultType get_type() const override { return GameResultType::tie; }
 
 private:
     std::reference_wrapper<const Player> dark_player;
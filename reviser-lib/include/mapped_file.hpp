@@ -0,0 +1,45 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_MAPPED_FILE_HPP
+#define REVISER_LIB_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace reviser {
+
+// A read-only memory mapping of a whole file. The contents are paged in by the
+// operating system on demand, so large files can be scanned without copying them
+// into heap memory. Throws `std::invalid_argument` if the file cannot be mapped.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path& path);
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(const MappedFile& other) = delete;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    [[nodiscard]] std::span<const std::uint8_t> get_data() const noexcept
+    {
+        return {data, size};
+    }
+
+private:
+    const std::uint8_t* data{};
+    std::size_t size{};
+#ifdef _WIN32
+    void* file_handle{};
+    void* mapping_handle{};
+#endif
+
+    void unmap() noexcept;
+};
+
+} // namespace reviser
+
+#endif // REVISER_LIB_MAPPED_FILE_HPP
@@ -0,0 +1,105 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_NOTIFIERS_HPP
+#define REVISER_LIB_NOTIFIERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "game.hpp"
+#include "game_result.hpp"
+#include "position.hpp"
+
+namespace reviser {
+
+// Ignores all notifications. Since the class is `final` and its members are inline,
+// games that know the static type of their notifier (e.g., `StaticGame`) can drop
+// the calls entirely.
+class NullNotifier final : public Notifier
+{
+public:
+    void display_message(std::string_view message) override {}
+    void display_board(const BasicBoard& board) override {}
+    void note_new_game(const Players& players, const BasicBoard& board) override {}
+    void note_move(const Player& player, Position pos, const BasicBoard& board) override {}
+    void note_result(const GameResult& result) override {}
+};
+
+// Records games into a compact in-memory log without producing any text. The log can
+// later be replayed into another notifier or rendered with `to_string()`, which gives
+// the same output that a `Notifier` writing each message on its own line would have
+// produced while the games were running.
+class BufferedNotifier final : public Notifier
+{
+public:
+    struct RecordedMove
+    {
+        std::uint8_t linear_index{};
+        PlayerColor color{};
+
+        [[nodiscard]] Position get_position() const
+        {
+            return Position::from_linear_index(linear_index);
+        }
+    };
+
+    struct RecordedResult
+    {
+        GameResultType type{};
+        // The winner for decisive results, dark for ties.
+        PlayerColor winner{};
+        Score score;
+    };
+
+    struct GameRecord
+    {
+        std::string dark_player_name{};
+        std::string light_player_name{};
+        std::array<Field, 64> initial_fields{};
+        std::vector<RecordedMove> moves{};
+        std::optional<RecordedResult> result{};
+    };
+
+    void display_message(std::string_view message) override;
+    void note_new_game(const Players& players, const BasicBoard& board) override;
+    void note_move(const Player& player, Position pos, const BasicBoard& board) override;
+    void note_result(const GameResult& result) override;
+
+    [[nodiscard]] const std::vector<GameRecord>& get_games() const noexcept
+    {
+        return games;
+    }
+
+    // Sends all recorded notifications to `notifier`, in the order in which they were
+    // received.
+    void replay(Notifier& notifier) const;
+
+    [[nodiscard]] std::string to_string() const;
+
+    void clear();
+
+private:
+    // A message that was displayed directly, after `num_events` moves and results of
+    // the `num_games`-th game.
+    struct RecordedMessage
+    {
+        std::size_t num_games{};
+        std::size_t num_events{};
+        std::string text{};
+    };
+
+    std::vector<GameRecord> games{};
+    std::vector<RecordedMessage> messages{};
+};
+
+} // namespace reviser
+
+#endif // REVISER_LIB_NOTIFIERS_HPP
@@ -0,0 +1,76 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_PERFT_HPP
+#define REVISER_LIB_PERFT_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "board.hpp"
+#include "common.hpp"
+
+namespace reviser {
+
+// Number of leaf nodes of the game tree from the initial `center_square` position,
+// indexed by depth. A pass counts as a ply; a finished game is a leaf. These are the
+// published Othello perft numbers; the initial position is a mirror image of the
+// standard one, which does not change the counts.
+inline constexpr std::array<std::uint64_t, 15> perft_reference_counts{
+    1,
+    4,
+    12,
+    56,
+    244,
+    1'396,
+    8'200,
+    55'092,
+    390'216,
+    3'005'288,
+    24'571'284,
+    212'258'800,
+    1'939'886'636,
+    18'429'641'748,
+    184'042'084'512,
+};
+
+[[nodiscard]] constexpr std::optional<std::uint64_t> find_perft_reference_count(int depth)
+{
+    if (depth < 0 || depth >= static_cast<int>(perft_reference_counts.size())) {
+        return std::nullopt;
+    }
+    return perft_reference_counts[depth];
+}
+
+// Counts the leaf nodes of the game tree of depth `depth` below `board` with `pc` to
+// move. The board is modified with `play_move()` and restored with `undo_move()`.
+template <BasicBoardType BoardT>
+[[nodiscard]] std::uint64_t
+perft(BoardT& board, const PlayerColor pc, const int depth, const bool opponent_passed = false)
+{
+    if (depth <= 0) {
+        return 1;
+    }
+    const auto moves = board.find_valid_moves(pc);
+    if (moves.empty()) {
+        if (opponent_passed) {
+            return 1;
+        }
+        return perft(board, other_player_color(pc), depth - 1, true);
+    }
+    if (depth == 1) {
+        return moves.size();
+    }
+    auto result = std::uint64_t{};
+    for (const auto move : moves) {
+        const auto record = board.play_move(pc, move);
+        result += perft(board, other_player_color(pc), depth - 1);
+        board.undo_move(record);
+    }
+    return result;
+}
+
+} // namespace reviser
+
+#endif // REVISER_LIB_PERFT_HPP
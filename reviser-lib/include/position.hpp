@@ -63,6 +63,13 @@ public:
         , column{column}
     {}
 
+    [[nodiscard]] static constexpr Position from_linear_index(const std::size_t index)
+    {
+        return {
+            Row{static_cast<int>(index / board_size)},
+            Column{static_cast<int>(index % board_size)}};
+    }
+
     [[nodiscard]] constexpr Row get_row() const { return row; }
     [[nodiscard]] constexpr Column get_column() const { return column; }
 
@@ -77,7 +84,7 @@ public:
         return {Row{row + d.get_dy()}, Column{column + d.get_dx()}};
     }
 
-    [[nodiscard]] std::size_t to_linear_index() const
+    [[nodiscard]] constexpr std::size_t to_linear_index() const
     {
         return row * board_size + column;
     }
@@ -0,0 +1,127 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_POSITION_SET_HPP
+#define REVISER_LIB_POSITION_SET_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iosfwd>
+#include <iterator>
+
+#include "position.hpp"
+
+namespace reviser {
+
+using Bits = std::uint64_t;
+
+// Bit i of a `Bits` value corresponds to the field with linear index i, i.e., bit 0 is
+// the top-left field and bit 63 the bottom-right one.
+[[nodiscard]] constexpr Bits position_bit(const Position pos)
+{
+    return Bits{1} << pos.to_linear_index();
+}
+
+// A set of board positions stored as a 64-bit mask. Iteration visits the positions in
+// ascending order, i.e., row by row.
+class PositionSet
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Position;
+        using difference_type = std::ptrdiff_t;
+        using reference = Position;
+        using pointer = void;
+
+        constexpr iterator() = default;
+
+        constexpr explicit iterator(const Bits remaining)
+            : remaining{remaining}
+        {}
+
+        constexpr Position operator*() const
+        {
+            return Position::from_linear_index(std::countr_zero(remaining));
+        }
+
+        constexpr iterator& operator++()
+        {
+            remaining &= remaining - 1;
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        constexpr bool operator==(const iterator& other) const = default;
+
+    private:
+        Bits remaining{};
+    };
+
+    using const_iterator = iterator;
+    using value_type = Position;
+    using size_type = std::size_t;
+
+    constexpr PositionSet() = default;
+
+    constexpr explicit PositionSet(const Bits bits)
+        : bits{bits}
+    {}
+
+    constexpr PositionSet(const std::initializer_list<Position> positions)
+    {
+        for (const auto pos : positions) {
+            insert(pos);
+        }
+    }
+
+    [[nodiscard]] constexpr Bits get_bits() const { return bits; }
+
+    [[nodiscard]] constexpr iterator begin() const { return iterator{bits}; }
+    [[nodiscard]] constexpr iterator end() const { return iterator{}; }
+
+    [[nodiscard]] constexpr bool empty() const { return bits == 0; }
+
+    [[nodiscard]] constexpr size_type size() const
+    {
+        return static_cast<size_type>(std::popcount(bits));
+    }
+
+    [[nodiscard]] constexpr bool contains(const Position pos) const
+    {
+        return (bits & position_bit(pos)) != 0;
+    }
+
+    constexpr void insert(const Position pos) { bits |= position_bit(pos); }
+
+    constexpr void erase(const Position pos) { bits &= ~position_bit(pos); }
+
+    constexpr void clear() { bits = 0; }
+
+    constexpr PositionSet& operator|=(const PositionSet other)
+    {
+        bits |= other.bits;
+        return *this;
+    }
+
+    constexpr bool operator==(const PositionSet& other) const = default;
+
+private:
+    Bits bits{};
+};
+
+std::ostream& operator<<(std::ostream& os, PositionSet positions);
+
+} // namespace reviser
+
+#endif // REVISER_LIB_POSITION_SET_HPP
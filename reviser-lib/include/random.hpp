@@ -0,0 +1,73 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_RANDOM_HPP
+#define REVISER_LIB_RANDOM_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace reviser {
+
+[[nodiscard]] constexpr std::uint64_t next_splitmix64(std::uint64_t& state)
+{
+    auto result = (state += 0x9e37'79b9'7f4a'7c15ULL);
+    result = (result ^ (result >> 30)) * 0xbf58'476d'1ce4'e5b9ULL;
+    result = (result ^ (result >> 27)) * 0x94d0'49bb'1331'11ebULL;
+    return result ^ (result >> 31);
+}
+
+// The xoshiro256++ generator: small, fast and of good statistical quality. Models
+// `std::uniform_random_bit_generator`.
+class Xoshiro256
+{
+public:
+    using result_type = std::uint64_t;
+
+    constexpr explicit Xoshiro256(const std::uint64_t seed_value = 0) { seed(seed_value); }
+
+    // The state is expanded from `seed_value` with splitmix64, so that similar seeds
+    // give unrelated sequences.
+    constexpr void seed(std::uint64_t seed_value)
+    {
+        for (auto& word : state) {
+            word = next_splitmix64(seed_value);
+        }
+    }
+
+    [[nodiscard]] static constexpr result_type min() { return 0; }
+    [[nodiscard]] static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr result_type operator()()
+    {
+        const auto result = std::rotl(state[0] + state[3], 23) + state[0];
+        const auto t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = std::rotl(state[3], 45);
+        return result;
+    }
+
+    // A random number in [0, bound) for bounds up to 2^32, computed with a single
+    // multiplication. The bias is at most `bound / 2^32`.
+    [[nodiscard]] constexpr std::size_t uniform_index(const std::size_t bound)
+    {
+        return static_cast<std::size_t>(((*this)() >> 32) * bound >> 32);
+    }
+
+private:
+    std::array<std::uint64_t, 4> state{};
+};
+
+} // namespace reviser
+
+#endif // REVISER_LIB_RANDOM_HPP
@@ -0,0 +1,58 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_RAYS_HPP
+#define REVISER_LIB_RAYS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "direction.hpp"
+#include "position.hpp"
+
+namespace reviser {
+
+// The linear indices of the fields reachable from a field by moving in a single
+// direction, ordered by distance from the starting field.
+struct Ray
+{
+    std::array<std::uint8_t, board_size - 1> indices{};
+    std::uint8_t length{};
+
+    [[nodiscard]] constexpr auto begin() const { return indices.begin(); }
+    [[nodiscard]] constexpr auto end() const { return indices.begin() + length; }
+    [[nodiscard]] constexpr bool empty() const { return length == 0; }
+};
+
+// The rays from a field in each of the eight `directions`, in the same order.
+using Rays = std::array<Ray, directions.size()>;
+
+[[nodiscard]] constexpr Ray compute_ray(const Position start, const Direction d)
+{
+    auto result = Ray{};
+    for (auto pos = start.next_in_direction(d); pos.is_valid();
+         pos = pos.next_in_direction(d)) {
+        result.indices[result.length++] = static_cast<std::uint8_t>(pos.to_linear_index());
+    }
+    return result;
+}
+
+inline constexpr std::array<Rays, 64> rays_from_field{[] {
+    auto result = std::array<Rays, 64>{};
+    for (auto index = 0u; index < result.size(); ++index) {
+        for (auto i = 0u; i < directions.size(); ++i) {
+            result[index][i] = compute_ray(Position::from_linear_index(index), directions[i]);
+        }
+    }
+    return result;
+}()};
+
+[[nodiscard]] constexpr const Rays& rays_from(const std::size_t index)
+{
+    return rays_from_field[index];
+}
+
+} // namespace reviser
+
+#endif // REVISER_LIB_RAYS_HPP
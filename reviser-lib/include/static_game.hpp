@@ -0,0 +1,178 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_STATIC_GAME_HPP
+#define REVISER_LIB_STATIC_GAME_HPP
+
+#include <concepts>
+#include <memory>
+#include <utility>
+
+#include "board.hpp"
+#include "game.hpp"
+#include "game_result.hpp"
+#include "player.hpp"
+
+namespace reviser {
+
+// A player that can pick moves on a `BoardT`. Every `Player` qualifies through its
+// virtual `pick_move(const BasicBoard&)`; a `final` player class with an overload of
+// `pick_move()` for `BoardT` is called without any virtual dispatch.
+template <typename PlayerT, typename BoardT>
+concept StaticPlayerFor = std::derived_from<PlayerT, Player>
+                          && requires(const PlayerT& player, const BoardT& board) {
+                                 // clang-format off
+    { player.pick_move(board) } -> std::convertible_to<Position>;
+                                 // clang-format on
+                             };
+
+// A game whose board, players and notifier have static types, so that the game loop
+// can be inlined for `final` classes. The interfaces of `Player` and `Notifier` are
+// used unchanged; instantiating it with `Notifier` and a player class that only
+// overrides the virtual `pick_move()` gives the same behavior as `DefaultGame`.
+template <
+    BoardType BoardT,
+    StaticPlayerFor<BoardT> FirstPlayerT,
+    StaticPlayerFor<BoardT> SecondPlayerT = FirstPlayerT,
+    std::derived_from<Notifier> NotifierT = Notifier>
+class StaticGame final : public Game
+{
+public:
+    // The first player plays dark until the players are swapped by `new_game()`.
+    StaticGame(
+        std::shared_ptr<FirstPlayerT> first_player,
+        std::shared_ptr<SecondPlayerT> second_player,
+        std::unique_ptr<NotifierT> notifier)
+        : first_player{first_player}
+        , second_player{second_player}
+        , players{std::move(first_player), std::move(second_player)}
+        , notifier{std::move(notifier)}
+    {}
+
+    void new_game(bool swap_players) override;
+
+    void run_game_loop() override;
+
+    [[nodiscard]] std::shared_ptr<const GameResult> get_result() const override
+    {
+        return result;
+    }
+
+    [[nodiscard]] const Players& get_players() const noexcept { return players; }
+
+    [[nodiscard]] const BoardT& get_board() const noexcept { return board; }
+
+    [[nodiscard]] const NotifierT& get_notifier() const noexcept { return *notifier; }
+
+private:
+    std::shared_ptr<FirstPlayerT> first_player;
+    std::shared_ptr<SecondPlayerT> second_player;
+    Players players;
+    std::unique_ptr<NotifierT> notifier;
+    BoardT board{};
+    std::shared_ptr<GameResult> result{};
+
+    [[nodiscard]] Position pick_move(PlayerColor pc) const;
+
+    [[nodiscard]] const Player& get_player(PlayerColor pc) const;
+
+    void set_result_from_score();
+};
+
+template <
+    BoardType BoardT,
+    StaticPlayerFor<BoardT> FirstPlayerT,
+    StaticPlayerFor<BoardT> SecondPlayerT,
+    std::derived_from<Notifier> NotifierT>
+void StaticGame<BoardT, FirstPlayerT, SecondPlayerT, NotifierT>::new_game(
+    const bool swap_players)
+{
+    result = nullptr;
+    board.initialize();
+    if (swap_players) {
+        players.swap_dark_and_light_player();
+    }
+    players.new_game();
+    notifier->note_new_game(players, board);
+}
+
+template <
+    BoardType BoardT,
+    StaticPlayerFor<BoardT> FirstPlayerT,
+    StaticPlayerFor<BoardT> SecondPlayerT,
+    std::derived_from<Notifier> NotifierT>
+void StaticGame<BoardT, FirstPlayerT, SecondPlayerT, NotifierT>::run_game_loop()
+{
+    auto pc = PlayerColor::dark;
+    auto opponent_passed = false;
+    while (!result) {
+        const auto moves = board.find_valid_moves(pc);
+        if (moves.empty()) {
+            if (opponent_passed) {
+                set_result_from_score();
+            }
+            opponent_passed = true;
+        }
+        else {
+            const auto move = pick_move(pc);
+            if (!moves.contains(move)) {
+                const auto& player = get_player(pc);
+                result = std::make_shared<WinByOpponentMistake>(
+                    board.compute_score(), board, players.get_other_player(player), player);
+                break;
+            }
+            board.play_move(pc, move);
+            notifier->note_move(get_player(pc), move, board);
+            opponent_passed = false;
+        }
+        pc = other_player_color(pc);
+    }
+    notifier->note_result(*result);
+}
+
+template <
+    BoardType BoardT,
+    StaticPlayerFor<BoardT> FirstPlayerT,
+    StaticPlayerFor<BoardT> SecondPlayerT,
+    std::derived_from<Notifier> NotifierT>
+Position
+StaticGame<BoardT, FirstPlayerT, SecondPlayerT, NotifierT>::pick_move(const PlayerColor pc) const
+{
+    if (first_player->get_color() == pc) {
+        return first_player->pick_move(board);
+    }
+    return second_player->pick_move(board);
+}
+
+template <
+    BoardType BoardT,
+    StaticPlayerFor<BoardT> FirstPlayerT,
+    StaticPlayerFor<BoardT> SecondPlayerT,
+    std::derived_from<Notifier> NotifierT>
+const Player&
+StaticGame<BoardT, FirstPlayerT, SecondPlayerT, NotifierT>::get_player(const PlayerColor pc) const
+{
+    return pc == PlayerColor::dark ? players.get_dark_player() : players.get_light_player();
+}
+
+template <
+    BoardType BoardT,
+    StaticPlayerFor<BoardT> FirstPlayerT,
+    StaticPlayerFor<BoardT> SecondPlayerT,
+    std::derived_from<Notifier> NotifierT>
+void StaticGame<BoardT, FirstPlayerT, SecondPlayerT, NotifierT>::set_result_from_score()
+{
+    const auto score = board.compute_score();
+    if (score.is_tied()) {
+        result = std::make_shared<TiedResult>(
+            score, board, players.get_dark_player(), players.get_light_player());
+    }
+    else {
+        const auto& [winner, loser] = score.compute_winner(players);
+        result = std::make_shared<WinByScore>(score, board, winner, loser);
+    }
+}
+
+} // namespace reviser
+
+#endif // REVISER_LIB_STATIC_GAME_HPP
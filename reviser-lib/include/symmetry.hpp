@@ -0,0 +1,195 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_SYMMETRY_HPP
+#define REVISER_LIB_SYMMETRY_HPP
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <utility>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "position.hpp"
+#include "position_set.hpp"
+
+namespace reviser {
+
+// The eight symmetries of the board. Rotations are clockwise; `flip_vertical` swaps
+// the top and bottom rows, `flip_horizontal` the left and right columns,
+// `flip_diagonal` mirrors at the diagonal from the top left to the bottom right
+// corner and `flip_anti_diagonal` at the other diagonal.
+enum class Symmetry : std::uint8_t
+{
+    identity,
+    rotate_90,
+    rotate_180,
+    rotate_270,
+    flip_vertical,
+    flip_horizontal,
+    flip_diagonal,
+    flip_anti_diagonal,
+};
+
+inline constexpr std::array<Symmetry, 8> all_symmetries{
+    Symmetry::identity,
+    Symmetry::rotate_90,
+    Symmetry::rotate_180,
+    Symmetry::rotate_270,
+    Symmetry::flip_vertical,
+    Symmetry::flip_horizontal,
+    Symmetry::flip_diagonal,
+    Symmetry::flip_anti_diagonal,
+};
+
+// The symmetry that undoes `symmetry`.
+[[nodiscard]] constexpr Symmetry inverse(const Symmetry symmetry)
+{
+    switch (symmetry) {
+    case Symmetry::rotate_90: return Symmetry::rotate_270;
+    case Symmetry::rotate_270: return Symmetry::rotate_90;
+    default: return symmetry;
+    }
+}
+
+[[nodiscard]] constexpr Position transform_position(const Position pos, const Symmetry symmetry)
+{
+    const int row = pos.get_row();
+    const int column = pos.get_column();
+    switch (symmetry) {
+    case Symmetry::identity: return pos;
+    case Symmetry::rotate_90: return {Row{column}, Column{7 - row}};
+    case Symmetry::rotate_180: return {Row{7 - row}, Column{7 - column}};
+    case Symmetry::rotate_270: return {Row{7 - column}, Column{row}};
+    case Symmetry::flip_vertical: return {Row{7 - row}, Column{column}};
+    case Symmetry::flip_horizontal: return {Row{row}, Column{7 - column}};
+    case Symmetry::flip_diagonal: return {Row{column}, Column{row}};
+    case Symmetry::flip_anti_diagonal: return {Row{7 - column}, Column{7 - row}};
+    }
+    return pos;
+}
+
+[[nodiscard]] constexpr Bits flip_bits_vertical(const Bits bits) { return std::byteswap(bits); }
+
+[[nodiscard]] constexpr Bits flip_bits_horizontal(Bits bits)
+{
+    constexpr Bits k1{0x5555'5555'5555'5555};
+    constexpr Bits k2{0x3333'3333'3333'3333};
+    constexpr Bits k4{0x0f0f'0f0f'0f0f'0f0f};
+    bits = ((bits >> 1) & k1) | ((bits & k1) << 1);
+    bits = ((bits >> 2) & k2) | ((bits & k2) << 2);
+    return ((bits >> 4) & k4) | ((bits & k4) << 4);
+}
+
+[[nodiscard]] constexpr Bits flip_bits_diagonal(Bits bits)
+{
+    constexpr Bits k1{0x5500'5500'5500'5500};
+    constexpr Bits k2{0x3333'0000'3333'0000};
+    constexpr Bits k4{0x0f0f'0f0f'0000'0000};
+    auto t = k4 & (bits ^ (bits << 28));
+    bits ^= t ^ (t >> 28);
+    t = k2 & (bits ^ (bits << 14));
+    bits ^= t ^ (t >> 14);
+    t = k1 & (bits ^ (bits << 7));
+    return bits ^ t ^ (t >> 7);
+}
+
+[[nodiscard]] constexpr Bits flip_bits_anti_diagonal(Bits bits)
+{
+    constexpr Bits k1{0xaa00'aa00'aa00'aa00};
+    constexpr Bits k2{0xcccc'0000'cccc'0000};
+    constexpr Bits k4{0xf0f0'f0f0'0f0f'0f0f};
+    auto t = bits ^ (bits << 36);
+    bits ^= k4 & (t ^ (bits >> 36));
+    t = k2 & (bits ^ (bits << 18));
+    bits ^= t ^ (t >> 18);
+    t = k1 & (bits ^ (bits << 9));
+    return bits ^ t ^ (t >> 9);
+}
+
+// Bit-parallel version of `transform_position()` for all fields of `bits`.
+[[nodiscard]] constexpr Bits transform_bits(const Bits bits, const Symmetry symmetry)
+{
+    switch (symmetry) {
+    case Symmetry::identity: return bits;
+    case Symmetry::rotate_90: return flip_bits_horizontal(flip_bits_diagonal(bits));
+    case Symmetry::rotate_180: return flip_bits_vertical(flip_bits_horizontal(bits));
+    case Symmetry::rotate_270: return flip_bits_vertical(flip_bits_diagonal(bits));
+    case Symmetry::flip_vertical: return flip_bits_vertical(bits);
+    case Symmetry::flip_horizontal: return flip_bits_horizontal(bits);
+    case Symmetry::flip_diagonal: return flip_bits_diagonal(bits);
+    case Symmetry::flip_anti_diagonal: return flip_bits_anti_diagonal(bits);
+    }
+    return bits;
+}
+
+// `symmetry_index_tables[s][i]` is the linear index of the field to which the
+// symmetry `s` moves the field with linear index `i`.
+inline constexpr auto symmetry_index_tables{[] {
+    auto result = std::array<std::array<std::uint8_t, 64>, 8>{};
+    for (const auto symmetry : all_symmetries) {
+        for (std::size_t i = 0; i < 64; ++i) {
+            result[static_cast<std::size_t>(symmetry)][i] = static_cast<std::uint8_t>(
+                transform_position(Position::from_linear_index(i), symmetry).to_linear_index());
+        }
+    }
+    return result;
+}()};
+
+// A board that can be transformed by the symmetries of the board.
+template <typename BoardT>
+concept SymmetricBoardType
+    = BasicBoardType<BoardT> && requires(const BoardT& board, Symmetry symmetry) {
+          // clang-format off
+    { board.transform(symmetry) } -> std::convertible_to<BoardT>;
+          // clang-format on
+      };
+
+template <typename BoardT>
+struct CanonicalForm
+{
+    BoardT board;
+    // The symmetry that maps the original board to `board`; moves on `board` are
+    // mapped back with `inverse(symmetry)`.
+    Symmetry symmetry;
+};
+
+// The canonical representative of the eight boards that are symmetric to `board`:
+// the one whose dark fields, and then light fields, form the smallest bit pattern.
+// All symmetric boards have the same canonical form.
+template <SymmetricBoardType BoardT>
+[[nodiscard]] CanonicalForm<BoardT> canonical_form(const BoardT& board)
+{
+    auto bits = std::pair<Bits, Bits>{};
+    if constexpr (requires { board.get_bits_for(PlayerColor::dark); }) {
+        bits = {board.get_bits_for(PlayerColor::dark), board.get_bits_for(PlayerColor::light)};
+    }
+    else {
+        for (const auto pos : all_board_positions()) {
+            if (const Field field = board[pos]; field == Field::dark) {
+                bits.first |= position_bit(pos);
+            }
+            else if (field == Field::light) {
+                bits.second |= position_bit(pos);
+            }
+        }
+    }
+
+    auto best_bits = bits;
+    auto best_symmetry = Symmetry::identity;
+    for (const auto symmetry : all_symmetries) {
+        const auto transformed_bits = std::pair{
+            transform_bits(bits.first, symmetry), transform_bits(bits.second, symmetry)};
+        if (transformed_bits < best_bits) {
+            best_bits = transformed_bits;
+            best_symmetry = symmetry;
+        }
+    }
+    return {board.transform(best_symmetry), best_symmetry};
+}
+
+} // namespace reviser
+
+#endif // REVISER_LIB_SYMMETRY_HPP
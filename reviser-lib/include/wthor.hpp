@@ -0,0 +1,134 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_WTHOR_HPP
+#define REVISER_LIB_WTHOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+
+#include "board.hpp"
+#include "common.hpp"
+#include "mapped_file.hpp"
+#include "position.hpp"
+
+namespace reviser {
+
+// WTHOR files start with a 16-byte header, followed by 68 bytes per game: the
+// tournament, black and white player numbers (16 bits, little endian), the number of
+// black discs at the end of the game and the theoretical score, and 60 moves. Moves
+// are encoded as 10 * row + column, with rows and columns numbered from 1, and 0
+// after the end of the game; passes are not recorded.
+inline constexpr std::size_t wthor_header_size{16};
+inline constexpr std::size_t wthor_game_size{68};
+inline constexpr std::size_t wthor_max_num_moves{60};
+
+// Converts a WTHOR move to a `Position`. WTHOR uses the standard Othello start
+// position, which is the mirror image of ours, so columns are mirrored as well.
+// Throws `std::invalid_argument` for invalid codes.
+[[nodiscard]] Position wthor_move_to_position(std::uint8_t move);
+
+[[nodiscard]] std::uint8_t position_to_wthor_move(Position pos);
+
+// A view of one game in a WTHOR database. Black is our dark player.
+class WthorGame
+{
+public:
+    explicit WthorGame(std::span<const std::uint8_t, wthor_game_size> bytes)
+        : bytes{bytes}
+    {}
+
+    [[nodiscard]] std::uint16_t get_tournament_id() const { return read_u16(0); }
+    [[nodiscard]] std::uint16_t get_dark_player_id() const { return read_u16(2); }
+    [[nodiscard]] std::uint16_t get_light_player_id() const { return read_u16(4); }
+    [[nodiscard]] int get_num_dark_discs() const { return bytes[6]; }
+    [[nodiscard]] int get_theoretical_num_dark_discs() const { return bytes[7]; }
+
+    [[nodiscard]] std::size_t get_num_moves() const;
+
+    [[nodiscard]] Position get_move(std::size_t index) const
+    {
+        return wthor_move_to_position(bytes[8 + index]);
+    }
+
+    [[nodiscard]] auto get_moves() const
+    {
+        return std::views::iota(std::size_t{0}, get_num_moves())
+               | std::views::transform([*this](std::size_t i) { return get_move(i); });
+    }
+
+private:
+    std::span<const std::uint8_t, wthor_game_size> bytes;
+
+    [[nodiscard]] std::uint16_t read_u16(const std::size_t offset) const
+    {
+        return static_cast<std::uint16_t>(bytes[offset] | bytes[offset + 1] << 8);
+    }
+};
+
+// A WTHOR game database (.wtb file). The games are accessed in place, either in a
+// memory-mapped file or in a buffer owned by the caller that must outlive the
+// database. Throws `std::invalid_argument` for files that are not 8x8 WTHOR game
+// databases.
+class WthorDatabase
+{
+public:
+    explicit WthorDatabase(const std::filesystem::path& path);
+    explicit WthorDatabase(std::span<const std::uint8_t> data);
+
+    [[nodiscard]] std::size_t size() const noexcept { return num_games; }
+
+    [[nodiscard]] WthorGame operator[](const std::size_t index) const
+    {
+        return WthorGame{data.subspan(wthor_header_size + index * wthor_game_size)
+                             .first<wthor_game_size>()};
+    }
+
+    [[nodiscard]] WthorGame at(std::size_t index) const;
+
+    // A random-access range of all games.
+    [[nodiscard]] auto get_games() const
+    {
+        return std::views::iota(std::size_t{0}, num_games)
+               | std::views::transform([this](std::size_t i) { return (*this)[i]; });
+    }
+
+    [[nodiscard]] int get_year() const { return data[10] | data[11] << 8; }
+
+private:
+    std::optional<MappedFile> mapped_file{};
+    std::span<const std::uint8_t> data{};
+    std::size_t num_games{};
+
+    void validate();
+};
+
+// Plays the moves of `game` on `board`, starting from the initial position, and
+// returns the color of the player to move. Passes are inserted where the recorded
+// move is not valid for the player to move but valid for the opponent; throws
+// `std::invalid_argument` if it is valid for neither.
+template <BasicBoardType BoardT>
+PlayerColor replay_wthor_game(const WthorGame& game, BoardT& board)
+{
+    board.initialize();
+    auto pc = PlayerColor::dark;
+    for (const auto pos : game.get_moves()) {
+        if (!board.play_move(pc, pos).was_played()) {
+            pc = other_player_color(pc);
+            if (!board.play_move(pc, pos).was_played()) {
+                throw std::invalid_argument("WTHOR game contains an invalid move.");
+            }
+        }
+        pc = other_player_color(pc);
+    }
+    return pc;
+}
+
+} // namespace reviser
+
+#endif // REVISER_LIB_WTHOR_HPP
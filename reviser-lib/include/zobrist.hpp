@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#pragma once
+#ifndef REVISER_LIB_ZOBRIST_HPP
+#define REVISER_LIB_ZOBRIST_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "common.hpp"
+#include "position_set.hpp"
+#include "random.hpp"
+
+namespace reviser {
+
+using ZobristHash = std::uint64_t;
+
+struct ZobristKeys
+{
+    std::array<ZobristHash, 64> dark_fields{};
+    std::array<ZobristHash, 64> light_fields{};
+    // `dark_fields[i] ^ light_fields[i]`, the change caused by flipping field i.
+    std::array<ZobristHash, 64> flipped_fields{};
+    ZobristHash light_to_move{};
+};
+
+inline constexpr ZobristKeys zobrist_keys{[] {
+    auto state = std::uint64_t{0x5265'7669'7365'72ULL};
+    auto result = ZobristKeys{};
+    for (auto i = 0u; i < 64; ++i) {
+        result.dark_fields[i] = next_splitmix64(state);
+        result.light_fields[i] = next_splitmix64(state);
+        result.flipped_fields[i] = result.dark_fields[i] ^ result.light_fields[i];
+    }
+    result.light_to_move = next_splitmix64(state);
+    return result;
+}()};
+
+[[nodiscard]] constexpr ZobristHash
+zobrist_key(const Field field, const std::size_t index)
+{
+    switch (field) {
+    case Field::dark: return zobrist_keys.dark_fields[index];
+    case Field::light: return zobrist_keys.light_fields[index];
+    case Field::empty: return ZobristHash{};
+    }
+    return ZobristHash{};
+}
+
+[[nodiscard]] constexpr ZobristHash zobrist_side_to_move_key(const PlayerColor pc)
+{
+    return pc == PlayerColor::light ? zobrist_keys.light_to_move : ZobristHash{};
+}
+
+// The hash of the position with the given dark and light fields; agrees with
+// `compute_zobrist_hash()` for boards.
+[[nodiscard]] constexpr ZobristHash
+compute_zobrist_hash(const Bits dark_bits, const Bits light_bits, const PlayerColor side_to_move)
+{
+    auto result = zobrist_side_to_move_key(side_to_move);
+    for (auto bits = dark_bits; bits != 0; bits &= bits - 1) {
+        result ^= zobrist_keys.dark_fields[std::countr_zero(bits)];
+    }
+    for (auto bits = light_bits; bits != 0; bits &= bits - 1) {
+        result ^= zobrist_keys.light_fields[std::countr_zero(bits)];
+    }
+    return result;
+}
+
+// The change of the hash when the fields in `flipped_positions` change their color.
+[[nodiscard]] constexpr ZobristHash
+zobrist_flip_key(const PositionSet flipped_positions)
+{
+    auto result = ZobristHash{};
+    for (auto bits = flipped_positions.get_bits(); bits != 0; bits &= bits - 1) {
+        result ^= zobrist_keys.flipped_fields[std::countr_zero(bits)];
+    }
+    return result;
+}
+
+} // namespace reviser
+
+#endif // REVISER_LIB_ZOBRIST_HPP
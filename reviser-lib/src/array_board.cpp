@@ -3,37 +3,36 @@
 #include "array_board.hpp"
 
 #include <algorithm>
-#include <cassert>
-#include <iterator>
-#include <map>
 
 #include "common.hpp"
-#include "direction.hpp"
 #include "position.hpp"
+#include "rays.hpp"
 
 namespace reviser {
 
-using ::std::ranges::copy_if;
-
 auto ArrayBoard::from_string(const std::string_view board_string) -> ArrayBoard
 {
     return BoardReader<ArrayBoard>::board_from_string(board_string);
 }
 
-auto ArrayBoard::operator[](const std::size_t index) -> Field&
+auto ArrayBoard::operator[](const Position pos) -> FieldReference<ArrayBoard>
 {
-    assert(index < 64);
-    return fields.at(index);
+    return FieldReference<ArrayBoard>{*this, pos};
 }
 
-auto ArrayBoard::operator[](const Position pos) -> Field&
+Field ArrayBoard::operator[](const Position pos) const
 {
     return fields.at(pos.to_linear_index());
 }
 
-const Field& ArrayBoard::operator[](const Position pos) const
+void ArrayBoard::set_field(const Position pos, const Field field)
 {
-    return fields.at(pos.to_linear_index());
+    const auto index = pos.to_linear_index();
+    auto& old_field = fields.at(index);
+    --count_of(old_field);
+    ++count_of(field);
+    hash ^= zobrist_key(old_field, index) ^ zobrist_key(field, index);
+    old_field = field;
 }
 
 std::string ArrayBoard::to_string() const
@@ -50,74 +49,40 @@ bool ArrayBoard::is_empty(Position pos) const { return field_is_empty((*this)[po
 
 bool ArrayBoard::is_valid_move(const PlayerColor pc, const Position pos) const
 {
-    return is_empty(pos) && does_move_flip_any_field(pc, pos);
+    return is_empty(pos)
+           && does_move_flip_any_field(field_for_player_color(pc), pos.to_linear_index());
 }
 
-bool ArrayBoard::does_move_flip_any_field(PlayerColor pc, Position starting_pos) const
+bool ArrayBoard::does_move_flip_any_field(
+    const Field player_field, const std::size_t index) const
 {
-    return std::ranges::any_of(directions, [&](auto d) {
-        return !positions_to_flip_in_direction(pc, starting_pos, d).empty();
+    return std::ranges::any_of(rays_from(index), [&](const Ray& ray) {
+        return !positions_to_flip_along_ray(player_field, ray).empty();
     });
 }
 
-ArrayBoard::Positions ArrayBoard::positions_to_flip_in_direction(
-    const PlayerColor pc, const Position starting_pos, const Direction d) const
-{
-    const auto next_pos = starting_pos.next_in_direction(d);
-    const auto occupied_positions = occupied_positions_in_direction(d, next_pos);
-    return filter_positions_that_can_be_flipped(pc, occupied_positions);
-}
-
-ArrayBoard::OrderedPositions ArrayBoard::occupied_positions_in_direction(
-    const Direction d, Position starting_pos) const
+ArrayBoard::Positions
+ArrayBoard::positions_to_flip_along_ray(const Field player_field, const Ray& ray) const
 {
-    auto occupied_positions = std::vector<Position>{};
-    while (starting_pos.is_valid()) {
-        if (!field_is_occupied((*this)[starting_pos])) {
+    auto result = Bits{};
+    for (const auto index : ray) {
+        const auto field = fields[index];
+        if (field == Field::empty) {
             break;
         }
-        occupied_positions.push_back(starting_pos);
-        starting_pos = starting_pos.next_in_direction(d);
-    }
-    return occupied_positions;
-}
-
-ArrayBoard::Positions ArrayBoard::filter_positions_that_can_be_flipped(
-    const PlayerColor pc, const OrderedPositions& non_empty_positions) const
-{
-    auto result = std::set<Position>{};
-    const auto highest_index
-        = find_highest_index_for_player_owned_fields(pc, non_empty_positions);
-
-    for (auto i = 0u; i < highest_index; ++i) {
-        auto& pos = non_empty_positions[i];
-        if (field_is_owned_by_opponent_of((*this)[pos], pc)) {
-            result.insert(pos);
-        }
-    }
-
-    return result;
-}
-
-std::size_t ArrayBoard::find_highest_index_for_player_owned_fields(
-    const PlayerColor pc, const OrderedPositions& non_empty_positions) const
-{
-    const auto num_non_empty_position = static_cast<int>(non_empty_positions.size());
-    for (int i = num_non_empty_position - 1; i >= 0; --i) {
-        const auto& position = Position{non_empty_positions[i]};
-        if (const auto& field = (*this)[position];
-            field_is_owned_by_player(field, pc)) {
-            return i;
+        if (field == player_field) {
+            return Positions{result};
         }
+        result |= Bits{1} << index;
     }
-    return 0;
+    return Positions{};
 }
 
 void ArrayBoard::initialize(const InitialBoardState initial_state)
 {
-    for (const auto pos : all_board_positions()) {
-        (*this)[pos] = Field::empty;
-    }
+    fields.fill(Field::empty);
+    field_counts = {64, 0, 0};
+    hash = ZobristHash{};
     if (initial_state == InitialBoardState::center_square) {
         (*this)[Position{Row{3}, Column{3}}] = Field::dark;
         (*this)[Position{Row{3}, Column{4}}] = Field::light;
@@ -128,53 +93,105 @@ void ArrayBoard::initialize(const InitialBoardState initial_state)
 
 ArrayBoard::Moves ArrayBoard::find_valid_moves(const PlayerColor pc) const
 {
-    auto result = std::set<Position>{};
-    for (auto pos : all_board_positions()) {
-        if (is_valid_move(pc, pos)) {
-            result.insert(pos);
+    const auto player_field = field_for_player_color(pc);
+    auto result = Bits{};
+    for (auto index = 0u; index < fields.size(); ++index) {
+        if (fields[index] == Field::empty
+            && does_move_flip_any_field(player_field, index)) {
+            result |= Bits{1} << index;
         }
     }
-    return result;
+    return Moves{result};
 }
 
-void ArrayBoard::play_move(const PlayerColor pc, const Position pos)
+FlipRecord ArrayBoard::play_move(const PlayerColor pc, const Position pos)
 {
-    if (is_valid_move(pc, pos)) {
-        (*this)[pos] = field_for_player_color(pc);
-        const auto flipped_positions = find_positions_flipped_by_move(pc, pos);
-        flip_positions(pc, flipped_positions);
+    if (!is_empty(pos)) {
+        return {pos, pc, Positions{}};
+    }
+    const auto player_field = field_for_player_color(pc);
+    const auto index = pos.to_linear_index();
+    const auto flipped_positions = find_positions_flipped_by_move(player_field, index);
+    if (!flipped_positions.empty()) {
+        const auto num_flipped = static_cast<int_fast8_t>(flipped_positions.size());
+        fields[index] = player_field;
+        flip_positions(player_field, flipped_positions);
+        --count_of(Field::empty);
+        count_of(player_field) += num_flipped + 1;
+        count_of(field_for_player_color(other_player_color(pc))) -= num_flipped;
+        hash ^= zobrist_key(player_field, index) ^ zobrist_flip_key(flipped_positions);
+    }
+    return {pos, pc, flipped_positions};
+}
+
+void ArrayBoard::undo_move(const FlipRecord record)
+{
+    if (record.was_played()) {
+        const auto player_field = field_for_player_color(record.player_color);
+        const auto opponent_field
+            = field_for_player_color(other_player_color(record.player_color));
+        const auto num_flipped
+            = static_cast<int_fast8_t>(record.flipped_positions.size());
+        fields[record.move.to_linear_index()] = Field::empty;
+        flip_positions(opponent_field, record.flipped_positions);
+        ++count_of(Field::empty);
+        count_of(player_field) -= num_flipped + 1;
+        count_of(opponent_field) += num_flipped;
+        hash ^= zobrist_key(player_field, record.move.to_linear_index())
+                ^ zobrist_flip_key(record.flipped_positions);
     }
 }
 
 Score ArrayBoard::compute_score() const
 {
-    std::map<Field, int_fast8_t> counts;
-    for (const auto pos : all_board_positions()) {
-        ++counts[(*this)[pos]];
-    }
-    return Score{counts};
+    return Score{
+        field_counts[static_cast<std::size_t>(Field::dark)],
+        field_counts[static_cast<std::size_t>(Field::light)],
+        field_counts[static_cast<std::size_t>(Field::empty)]};
 }
 
 ArrayBoard::Positions ArrayBoard::find_positions_flipped_by_move(
-    const PlayerColor pc, const Position pos) const
+    const Field player_field, const std::size_t index) const
 {
-    auto result = std::set<Position>{};
-    for (const auto d : directions) {
-        result.merge(positions_to_flip_in_direction(pc, pos, d));
+    auto result = Positions{};
+    for (const auto& ray : rays_from(index)) {
+        result |= positions_to_flip_along_ray(player_field, ray);
     }
     return result;
 }
 
 void ArrayBoard::flip_positions(
-    const PlayerColor pc, const ArrayBoard::Positions& positions_to_flip)
+    const Field player_field, const ArrayBoard::Positions positions_to_flip)
 {
-    const auto field = field_for_player_color(pc);
     for (const auto pos : positions_to_flip) {
-        (*this)[pos] = field;
+        fields[pos.to_linear_index()] = player_field;
+    }
+}
+
+ZobristHash ArrayBoard::get_hash(const PlayerColor side_to_move) const
+{
+    return hash ^ zobrist_side_to_move_key(side_to_move);
+}
+
+ArrayBoard ArrayBoard::transform(const Symmetry symmetry) const
+{
+    const auto& target_indices = symmetry_index_tables[static_cast<std::size_t>(symmetry)];
+    auto result = ArrayBoard{};
+    result.field_counts = field_counts;
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        const auto target_index = target_indices[i];
+        result.fields[target_index] = fields[i];
+        result.hash ^= zobrist_key(fields[i], target_index);
     }
+    return result;
 }
 
 
+int_fast8_t& ArrayBoard::count_of(const Field field)
+{
+    return field_counts[static_cast<std::size_t>(field)];
+}
+
 bool operator==(const ArrayBoard& lhs, const ArrayBoard& rhs)
 {
     return std::ranges::all_of(
@@ -0,0 +1,228 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "avx2_moves.hpp"
+
+#include <cstdint>
+
+#include "bit_board.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define REVISER_X86_64 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// MSVC compiles AVX2 intrinsics without special options; GCC and Clang need them
+// enabled per function so that the rest of the library runs on any x86-64 processor.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define REVISER_TARGET_AVX2
+#else
+#define REVISER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace reviser {
+
+#ifdef REVISER_X86_64
+
+namespace {
+
+struct CpuidRegisters
+{
+    unsigned eax{};
+    unsigned ebx{};
+    unsigned ecx{};
+    unsigned edx{};
+};
+
+CpuidRegisters cpuid(const unsigned leaf, const unsigned subleaf)
+{
+    auto result = CpuidRegisters{};
+#ifdef _MSC_VER
+    int registers[4]{};
+    __cpuidex(registers, static_cast<int>(leaf), static_cast<int>(subleaf));
+    result = {
+        static_cast<unsigned>(registers[0]),
+        static_cast<unsigned>(registers[1]),
+        static_cast<unsigned>(registers[2]),
+        static_cast<unsigned>(registers[3])};
+#else
+    if (leaf > __get_cpuid_max(0, nullptr)) {
+        return result;
+    }
+    __cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+    return result;
+}
+
+// The register state that the operating system saves on context switches.
+std::uint64_t read_xcr0()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned eax{};
+    unsigned edx{};
+    __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+bool detect_avx2()
+{
+    constexpr unsigned osxsave_bit{1u << 27};
+    constexpr unsigned avx_bit{1u << 28};
+    constexpr unsigned avx2_bit{1u << 5};
+    // The SSE and AVX halves of the YMM registers.
+    constexpr std::uint64_t ymm_state{0b110};
+
+    const auto features = cpuid(1, 0);
+    if ((features.ecx & (osxsave_bit | avx_bit)) != (osxsave_bit | avx_bit)
+        || (read_xcr0() & ymm_state) != ymm_state) {
+        return false;
+    }
+    return (cpuid(7, 0).ebx & avx2_bit) != 0;
+}
+
+// The shifts of the directions with positive amounts, in the order of their lanes.
+// The other four directions are the same shifts in the opposite direction, whose
+// masks swap the columns that they exclude.
+constexpr int lane_shifts[4]{1, 8, 9, 7};
+
+REVISER_TARGET_AVX2 __m256i make_lane_shifts(const int factor)
+{
+    return _mm256_setr_epi64x(
+        factor * lane_shifts[0],
+        factor * lane_shifts[1],
+        factor * lane_shifts[2],
+        factor * lane_shifts[3]);
+}
+
+struct LaneShifts
+{
+    __m256i amount;
+    __m256i amount_2;
+    __m256i amount_4;
+    __m256i left_mask;
+    __m256i right_mask;
+};
+
+REVISER_TARGET_AVX2 LaneShifts make_shifts()
+{
+    constexpr auto c0 = static_cast<long long>(not_column_0_bits);
+    constexpr auto c7 = static_cast<long long>(not_column_7_bits);
+    constexpr auto all = static_cast<long long>(all_fields_bits);
+    return {
+        make_lane_shifts(1),
+        make_lane_shifts(2),
+        make_lane_shifts(4),
+        _mm256_setr_epi64x(c0, all, c0, c7),
+        _mm256_setr_epi64x(c7, all, c7, c0)};
+}
+
+// Kogge-Stone occluded fills like `occluded_fill()`, in four directions at once.
+REVISER_TARGET_AVX2 __m256i
+occluded_fill_left(__m256i generator, __m256i propagator, const LaneShifts& s)
+{
+    propagator = _mm256_and_si256(propagator, s.left_mask);
+    generator = _mm256_or_si256(
+        generator, _mm256_and_si256(propagator, _mm256_sllv_epi64(generator, s.amount)));
+    propagator = _mm256_and_si256(propagator, _mm256_sllv_epi64(propagator, s.amount));
+    generator = _mm256_or_si256(
+        generator, _mm256_and_si256(propagator, _mm256_sllv_epi64(generator, s.amount_2)));
+    propagator = _mm256_and_si256(propagator, _mm256_sllv_epi64(propagator, s.amount_2));
+    return _mm256_or_si256(
+        generator, _mm256_and_si256(propagator, _mm256_sllv_epi64(generator, s.amount_4)));
+}
+
+REVISER_TARGET_AVX2 __m256i
+occluded_fill_right(__m256i generator, __m256i propagator, const LaneShifts& s)
+{
+    propagator = _mm256_and_si256(propagator, s.right_mask);
+    generator = _mm256_or_si256(
+        generator, _mm256_and_si256(propagator, _mm256_srlv_epi64(generator, s.amount)));
+    propagator = _mm256_and_si256(propagator, _mm256_srlv_epi64(propagator, s.amount));
+    generator = _mm256_or_si256(
+        generator, _mm256_and_si256(propagator, _mm256_srlv_epi64(generator, s.amount_2)));
+    propagator = _mm256_and_si256(propagator, _mm256_srlv_epi64(propagator, s.amount_2));
+    return _mm256_or_si256(
+        generator, _mm256_and_si256(propagator, _mm256_srlv_epi64(generator, s.amount_4)));
+}
+
+REVISER_TARGET_AVX2 Bits or_lanes(const __m256i bits)
+{
+    const auto halves
+        = _mm_or_si128(_mm256_castsi256_si128(bits), _mm256_extracti128_si256(bits, 1));
+    return static_cast<Bits>(
+        _mm_cvtsi128_si64(_mm_or_si128(halves, _mm_unpackhi_epi64(halves, halves))));
+}
+
+} // namespace
+
+bool has_avx2_support()
+{
+    static const bool result{detect_avx2()};
+    return result;
+}
+
+REVISER_TARGET_AVX2 Bits find_move_bits_avx2(const Bits player, const Bits opponent)
+{
+    const auto s = make_shifts();
+    const auto p = _mm256_set1_epi64x(static_cast<long long>(player));
+    const auto o = _mm256_set1_epi64x(static_cast<long long>(opponent));
+
+    const auto left_fill = occluded_fill_left(p, o, s);
+    const auto left_moves = _mm256_and_si256(
+        _mm256_sllv_epi64(_mm256_and_si256(left_fill, o), s.amount), s.left_mask);
+    const auto right_fill = occluded_fill_right(p, o, s);
+    const auto right_moves = _mm256_and_si256(
+        _mm256_srlv_epi64(_mm256_and_si256(right_fill, o), s.amount), s.right_mask);
+
+    return or_lanes(_mm256_or_si256(left_moves, right_moves)) & ~(player | opponent);
+}
+
+REVISER_TARGET_AVX2 Bits
+find_flip_bits_avx2(const Bits player, const Bits opponent, const Bits move)
+{
+    const auto s = make_shifts();
+    const auto p = _mm256_set1_epi64x(static_cast<long long>(player));
+    const auto o = _mm256_set1_epi64x(static_cast<long long>(opponent));
+    const auto m = _mm256_set1_epi64x(static_cast<long long>(move));
+    const auto zero = _mm256_setzero_si256();
+
+    // A direction flips the opponent's discs of its fill if the fill ends at one of
+    // the player's discs.
+    const auto left_fill = occluded_fill_left(m, o, s);
+    const auto left_ends = _mm256_and_si256(
+        _mm256_sllv_epi64(left_fill, s.amount), _mm256_and_si256(s.left_mask, p));
+    const auto left_flips = _mm256_andnot_si256(
+        _mm256_cmpeq_epi64(left_ends, zero), _mm256_and_si256(left_fill, o));
+    const auto right_fill = occluded_fill_right(m, o, s);
+    const auto right_ends = _mm256_and_si256(
+        _mm256_srlv_epi64(right_fill, s.amount), _mm256_and_si256(s.right_mask, p));
+    const auto right_flips = _mm256_andnot_si256(
+        _mm256_cmpeq_epi64(right_ends, zero), _mm256_and_si256(right_fill, o));
+
+    return or_lanes(_mm256_or_si256(left_flips, right_flips));
+}
+
+#else
+
+bool has_avx2_support() { return false; }
+
+Bits find_move_bits_avx2(const Bits player, const Bits opponent)
+{
+    return find_move_bits(player, opponent);
+}
+
+Bits find_flip_bits_avx2(const Bits player, const Bits opponent, const Bits move)
+{
+    return find_flip_bits(player, opponent, move);
+}
+
+#endif
+
+} // namespace reviser
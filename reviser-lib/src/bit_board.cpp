@@ -0,0 +1,167 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "bit_board.hpp"
+
+#include <bit>
+
+#include "avx2_moves.hpp"
+
+namespace reviser {
+
+namespace {
+// The move generator is chosen once, when the library is loaded; the branch on it is
+// predicted perfectly afterwards.
+const bool use_avx2{has_avx2_support()};
+} // namespace
+
+auto BitBoard::from_string(const std::string_view board_string) -> BitBoard
+{
+    return BoardReader<BitBoard>::board_from_string(board_string);
+}
+
+auto BitBoard::operator[](const Position pos) -> FieldReference<BitBoard>
+{
+    return FieldReference<BitBoard>{*this, pos};
+}
+
+Field BitBoard::operator[](const Position pos) const
+{
+    const auto bit = position_bit(pos);
+    if (dark_fields & bit) {
+        return Field::dark;
+    }
+    if (light_fields & bit) {
+        return Field::light;
+    }
+    return Field::empty;
+}
+
+void BitBoard::set_field(const Position pos, const Field field)
+{
+    const auto bit = position_bit(pos);
+    const auto index = pos.to_linear_index();
+    hash ^= zobrist_key((*this)[pos], index) ^ zobrist_key(field, index);
+    dark_fields &= ~bit;
+    light_fields &= ~bit;
+    switch (field) {
+    case Field::dark: dark_fields |= bit; break;
+    case Field::light: light_fields |= bit; break;
+    case Field::empty: break;
+    }
+}
+
+std::string BitBoard::to_string() const
+{
+    return BoardWriter<BitBoard>::board_to_string(*this);
+}
+
+void BitBoard::initialize(const InitialBoardState initial_state)
+{
+    dark_fields = Bits{};
+    light_fields = Bits{};
+    hash = ZobristHash{};
+    if (initial_state == InitialBoardState::center_square) {
+        set_field(Position{Row{3}, Column{3}}, Field::dark);
+        set_field(Position{Row{3}, Column{4}}, Field::light);
+        set_field(Position{Row{4}, Column{3}}, Field::light);
+        set_field(Position{Row{4}, Column{4}}, Field::dark);
+    }
+}
+
+bool BitBoard::is_empty(const Position pos) const
+{
+    return (get_empty_bits() & position_bit(pos)) != 0;
+}
+
+bool BitBoard::is_occupied(const Position pos) const { return !is_empty(pos); }
+
+bool BitBoard::is_valid_move(const PlayerColor pc, const Position pos) const
+{
+    const auto move = position_bit(pos);
+    return (get_empty_bits() & move) && find_flip_bits_for_move(pc, move) != 0;
+}
+
+BitBoard::Moves BitBoard::find_valid_moves(const PlayerColor pc) const
+{
+    return Moves{find_valid_move_bits(pc)};
+}
+
+FlipRecord BitBoard::play_move(const PlayerColor pc, const Position pos)
+{
+    const auto move = position_bit(pos);
+    if (!(get_empty_bits() & move)) {
+        return {pos, pc, Positions{}};
+    }
+    const auto flips = find_flip_bits_for_move(pc, move);
+    if (flips != 0) {
+        get_bits_for(pc) |= move | flips;
+        get_bits_for(other_player_color(pc)) &= ~flips;
+        hash ^= zobrist_key(field_for_player_color(pc), pos.to_linear_index())
+                ^ zobrist_flip_key(Positions{flips});
+    }
+    return {pos, pc, Positions{flips}};
+}
+
+void BitBoard::undo_move(const FlipRecord record)
+{
+    if (record.was_played()) {
+        const auto flips = record.flipped_positions.get_bits();
+        get_bits_for(record.player_color) &= ~(position_bit(record.move) | flips);
+        get_bits_for(other_player_color(record.player_color)) |= flips;
+        hash ^= zobrist_key(
+                    field_for_player_color(record.player_color),
+                    record.move.to_linear_index())
+                ^ zobrist_flip_key(record.flipped_positions);
+    }
+}
+
+Score BitBoard::compute_score() const
+{
+    const auto num_dark_fields = std::popcount(dark_fields);
+    const auto num_light_fields = std::popcount(light_fields);
+    return Score{
+        static_cast<int_fast8_t>(num_dark_fields),
+        static_cast<int_fast8_t>(num_light_fields),
+        static_cast<int_fast8_t>(64 - num_dark_fields - num_light_fields)};
+}
+
+ZobristHash BitBoard::get_hash(const PlayerColor side_to_move) const
+{
+    return hash ^ zobrist_side_to_move_key(side_to_move);
+}
+
+BitBoard BitBoard::transform(const Symmetry symmetry) const
+{
+    auto result = BitBoard{};
+    result.dark_fields = transform_bits(dark_fields, symmetry);
+    result.light_fields = transform_bits(light_fields, symmetry);
+    result.hash = compute_zobrist_hash(result.dark_fields, result.light_fields, PlayerColor::dark);
+    return result;
+}
+
+Bits BitBoard::get_bits_for(const PlayerColor pc) const
+{
+    return pc == PlayerColor::dark ? dark_fields : light_fields;
+}
+
+Bits& BitBoard::get_bits_for(const PlayerColor pc)
+{
+    return pc == PlayerColor::dark ? dark_fields : light_fields;
+}
+
+Bits BitBoard::find_valid_move_bits(const PlayerColor pc) const
+{
+    const auto player = get_bits_for(pc);
+    const auto opponent = get_bits_for(other_player_color(pc));
+    return use_avx2 ? find_move_bits_avx2(player, opponent) : find_move_bits(player, opponent);
+}
+
+Bits BitBoard::find_flip_bits_for_move(const PlayerColor pc, const Bits move) const
+{
+    const auto player = get_bits_for(pc);
+    const auto opponent = get_bits_for(other_player_color(pc));
+    return use_avx2 ? find_flip_bits_avx2(player, opponent, move)
+                    : find_flip_bits(player, opponent, move);
+}
+
+} // namespace reviser
@@ -0,0 +1,193 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "game_record.hpp"
+
+#include <limits>
+
+#include "player.hpp"
+
+namespace reviser {
+
+namespace {
+
+constexpr std::size_t fixed_payload_size{1 + 8 + 3};
+constexpr std::size_t header_size{game_record_magic.size() + 1};
+
+void append_u8(std::string& buffer, const std::uint64_t value)
+{
+    buffer.push_back(static_cast<char>(value & 0xff));
+}
+
+void append_u64(std::string& buffer, const std::uint64_t value)
+{
+    for (int i = 0; i < 64; i += 8) {
+        append_u8(buffer, value >> i);
+    }
+}
+
+void append_name(std::string& buffer, const std::string_view name)
+{
+    if (name.size() > std::numeric_limits<std::uint8_t>::max()) {
+        throw std::invalid_argument("Player names in game records are limited to 255 bytes.");
+    }
+    append_u8(buffer, name.size());
+    buffer += name;
+}
+
+// Reads from a payload, checking that it is long enough.
+class PayloadParser
+{
+public:
+    explicit PayloadParser(const std::string_view payload)
+        : payload{payload}
+    {}
+
+    std::uint8_t read_u8()
+    {
+        return static_cast<std::uint8_t>(read_bytes(1)[0]);
+    }
+
+    std::uint64_t read_u64()
+    {
+        const auto bytes = read_bytes(8);
+        auto result = std::uint64_t{};
+        for (int i = 7; i >= 0; --i) {
+            result = result << 8 | static_cast<std::uint8_t>(bytes[i]);
+        }
+        return result;
+    }
+
+    std::string_view read_name() { return read_bytes(read_u8()); }
+
+    std::string_view read_rest() { return read_bytes(payload.size() - offset); }
+
+private:
+    std::string_view payload;
+    std::size_t offset{};
+
+    std::string_view read_bytes(const std::size_t count)
+    {
+        if (payload.size() - offset < count) {
+            throw std::invalid_argument("Game record is truncated.");
+        }
+        const auto result = payload.substr(offset, count);
+        offset += count;
+        return result;
+    }
+};
+
+} // namespace
+
+GameRecordWriter::GameRecordWriter(std::ostream& out)
+    : out{&out}
+{
+    out.write(game_record_magic.data(), game_record_magic.size());
+    out.put(static_cast<char>(game_record_version));
+}
+
+void GameRecordWriter::note_new_game(const Players& players, const BasicBoard& board)
+{
+    current_record.dark_player_name = players.get_dark_player().get_name();
+    current_record.light_player_name = players.get_light_player().get_name();
+    current_record.moves.clear();
+    next_color = PlayerColor::dark;
+}
+
+void GameRecordWriter::note_move(
+    const Player& player, const Position pos, const BasicBoard& board)
+{
+    // Notifiers are not told about passes; a player moving twice in a row means that
+    // the opponent had to pass.
+    if (player.get_color() != next_color) {
+        current_record.moves.push_back(game_record_pass);
+    }
+    current_record.moves.push_back(static_cast<std::uint8_t>(pos.to_linear_index()));
+    next_color = other_player_color(player.get_color());
+}
+
+void GameRecordWriter::note_result(const GameResult& result)
+{
+    current_record.result_type = result.get_type();
+    current_record.seed = seed;
+    current_record.score = result.get_score();
+    write(current_record);
+}
+
+void GameRecordWriter::write(const GameRecord& record)
+{
+    buffer.assign(2, '\0');
+    append_u8(buffer, static_cast<std::uint8_t>(record.result_type));
+    append_u64(buffer, record.seed);
+    append_u8(buffer, record.score.get_num_dark_fields());
+    append_u8(buffer, record.score.get_num_light_fields());
+    append_u8(buffer, record.score.get_num_empty_fields());
+    append_name(buffer, record.dark_player_name);
+    append_name(buffer, record.light_player_name);
+    buffer.append(record.moves.begin(), record.moves.end());
+
+    const auto payload_size = buffer.size() - 2;
+    if (payload_size > std::numeric_limits<std::uint16_t>::max()) {
+        throw std::invalid_argument("Game record is too long.");
+    }
+    buffer[0] = static_cast<char>(payload_size & 0xff);
+    buffer[1] = static_cast<char>(payload_size >> 8);
+    out->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    ++num_games_written;
+}
+
+GameRecordReader::GameRecordReader(std::istream& in)
+    : in{&in}
+{
+    char header[header_size]{};
+    in.read(header, header_size);
+    if (in.gcount() != header_size
+        || std::string_view{header, game_record_magic.size()} != game_record_magic
+        || static_cast<std::uint8_t>(header[header_size - 1]) != game_record_version) {
+        throw std::invalid_argument("Stream does not contain game records.");
+    }
+}
+
+bool GameRecordReader::read_next(GameRecord& record)
+{
+    char length_bytes[2]{};
+    in->read(length_bytes, 2);
+    if (in->gcount() == 0) {
+        return false;
+    }
+    if (in->gcount() != 2) {
+        throw std::invalid_argument("Game record is truncated.");
+    }
+    const auto payload_size = static_cast<std::size_t>(
+        static_cast<std::uint8_t>(length_bytes[0])
+        | static_cast<std::uint8_t>(length_bytes[1]) << 8);
+    if (payload_size < fixed_payload_size) {
+        throw std::invalid_argument("Game record is truncated.");
+    }
+    buffer.resize(payload_size);
+    in->read(buffer.data(), static_cast<std::streamsize>(payload_size));
+    if (static_cast<std::size_t>(in->gcount()) != payload_size) {
+        throw std::invalid_argument("Game record is truncated.");
+    }
+
+    auto parser = PayloadParser{buffer};
+    const auto result_type = parser.read_u8();
+    if (result_type > static_cast<std::uint8_t>(GameResultType::tie)) {
+        throw std::invalid_argument("Game record has an invalid result type.");
+    }
+    record.result_type = static_cast<GameResultType>(result_type);
+    record.seed = parser.read_u64();
+    const auto num_dark_fields = parser.read_u8();
+    const auto num_light_fields = parser.read_u8();
+    const auto num_empty_fields = parser.read_u8();
+    record.score = Score{
+        static_cast<int_fast8_t>(num_dark_fields),
+        static_cast<int_fast8_t>(num_light_fields),
+        static_cast<int_fast8_t>(num_empty_fields)};
+    record.dark_player_name = parser.read_name();
+    record.light_player_name = parser.read_name();
+    const auto moves = parser.read_rest();
+    record.moves.assign(moves.begin(), moves.end());
+    return true;
+}
+
+} // namespace reviser
@@ -0,0 +1,153 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace reviser {
+
+namespace {
+
+[[noreturn]] void throw_mapping_error(const std::filesystem::path& path)
+{
+    throw std::invalid_argument("Could not map file " + path.string() + ".");
+}
+
+} // namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    const auto file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw_mapping_error(path);
+    }
+    file_handle = file;
+
+    auto file_size = LARGE_INTEGER{};
+    if (!GetFileSizeEx(file, &file_size)) {
+        unmap();
+        throw_mapping_error(path);
+    }
+    size = static_cast<std::size_t>(file_size.QuadPart);
+    if (size == 0) {
+        return;
+    }
+
+    mapping_handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        unmap();
+        throw_mapping_error(path);
+    }
+    data = static_cast<const std::uint8_t*>(
+        MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (data == nullptr) {
+        unmap();
+        throw_mapping_error(path);
+    }
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle != nullptr) {
+        CloseHandle(file_handle);
+    }
+    data = nullptr;
+    size = 0;
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    const auto fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw_mapping_error(path);
+    }
+    struct stat file_status
+    {};
+    if (fstat(fd, &file_status) != 0) {
+        close(fd);
+        throw_mapping_error(path);
+    }
+    size = static_cast<std::size_t>(file_status.st_size);
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            throw_mapping_error(path);
+        }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        data = static_cast<const std::uint8_t*>(mapping);
+    }
+    // The mapping stays valid after the file descriptor is closed.
+    close(fd);
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (data != nullptr) {
+        munmap(const_cast<std::uint8_t*>(data), size);
+    }
+    data = nullptr;
+    size = 0;
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data{std::exchange(other.data, nullptr)}
+    , size{std::exchange(other.size, 0)}
+#ifdef _WIN32
+    , file_handle{std::exchange(other.file_handle, nullptr)}
+    , mapping_handle{std::exchange(other.mapping_handle, nullptr)}
+#endif
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+#ifdef _WIN32
+        file_handle = std::exchange(other.file_handle, nullptr);
+        mapping_handle = std::exchange(other.mapping_handle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() { unmap(); }
+
+} // namespace reviser
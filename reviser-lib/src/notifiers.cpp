@@ -0,0 +1,158 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "notifiers.hpp"
+
+#include <memory>
+#include <stdexcept>
+
+#include "array_board.hpp"
+#include "player.hpp"
+
+namespace reviser {
+
+namespace {
+
+// Stands in for the players of a recorded game during replay.
+class ReplayedPlayer final : public Player
+{
+public:
+    using Player::Player;
+
+    [[nodiscard]] Position pick_move(const BasicBoard& board) const override
+    {
+        throw std::logic_error("Replayed players cannot pick moves.");
+    }
+};
+
+class StringNotifier final : public Notifier
+{
+public:
+    void display_message(const std::string_view message) override
+    {
+        output += message;
+        output += '\n';
+    }
+
+    std::string output{};
+};
+
+const Player& get_player(const Players& players, const PlayerColor pc)
+{
+    return pc == PlayerColor::dark ? players.get_dark_player() : players.get_light_player();
+}
+
+std::unique_ptr<GameResult> make_result(
+    const BufferedNotifier::RecordedResult& result,
+    const BasicBoard& board,
+    const Players& players)
+{
+    const auto& winner = get_player(players, result.winner);
+    const auto& loser = players.get_other_player(winner);
+    switch (result.type) {
+    case GameResultType::win_by_score:
+        return std::make_unique<WinByScore>(result.score, board, winner, loser);
+    case GameResultType::win_by_opponent_mistake:
+        return std::make_unique<WinByOpponentMistake>(result.score, board, winner, loser);
+    case GameResultType::tie:
+        break;
+    }
+    return std::make_unique<TiedResult>(
+        result.score, board, players.get_dark_player(), players.get_light_player());
+}
+
+} // namespace
+
+void BufferedNotifier::display_message(const std::string_view message)
+{
+    const auto num_events = games.empty()
+                                ? std::size_t{0}
+                                : games.back().moves.size() + (games.back().result ? 1 : 0);
+    messages.emplace_back(games.size(), num_events, std::string{message});
+}
+
+void BufferedNotifier::note_new_game(const Players& players, const BasicBoard& board)
+{
+    auto& game = games.emplace_back();
+    game.dark_player_name = players.get_dark_player().get_name();
+    game.light_player_name = players.get_light_player().get_name();
+    for (const auto pos : all_board_positions()) {
+        game.initial_fields[pos.to_linear_index()] = board[pos];
+    }
+    game.moves.reserve(60);
+}
+
+void BufferedNotifier::note_move(
+    const Player& player, const Position pos, const BasicBoard& board)
+{
+    if (games.empty()) {
+        throw std::logic_error("BufferedNotifier received a move before a new game.");
+    }
+    games.back().moves.push_back(
+        {static_cast<std::uint8_t>(pos.to_linear_index()), player.get_color()});
+}
+
+void BufferedNotifier::note_result(const GameResult& result)
+{
+    if (games.empty()) {
+        throw std::logic_error("BufferedNotifier received a result before a new game.");
+    }
+    const auto type = result.get_type();
+    const auto winner = type == GameResultType::tie
+                            ? PlayerColor::dark
+                            : static_cast<const DecisiveGameResult&>(result)
+                                  .get_winner()
+                                  .get_color();
+    games.back().result = RecordedResult{type, winner, result.get_score()};
+}
+
+void BufferedNotifier::replay(Notifier& notifier) const
+{
+    auto next_message = messages.begin();
+    const auto replay_messages = [&](const std::size_t num_games, const std::size_t num_events) {
+        while (next_message != messages.end() && next_message->num_games == num_games
+               && next_message->num_events == num_events) {
+            notifier.display_message(next_message->text);
+            ++next_message;
+        }
+    };
+
+    replay_messages(0, 0);
+    for (std::size_t game_index = 0; game_index < games.size(); ++game_index) {
+        const auto& game = games[game_index];
+        const auto players = Players{
+            std::make_shared<ReplayedPlayer>(game.dark_player_name),
+            std::make_shared<ReplayedPlayer>(game.light_player_name)};
+        auto board = ArrayBoard{};
+        for (const auto pos : all_board_positions()) {
+            board.set_field(pos, game.initial_fields[pos.to_linear_index()]);
+        }
+
+        auto num_events = std::size_t{0};
+        notifier.note_new_game(players, board);
+        replay_messages(game_index + 1, num_events);
+        for (const auto& move : game.moves) {
+            board.play_move(move.color, move.get_position());
+            notifier.note_move(get_player(players, move.color), move.get_position(), board);
+            replay_messages(game_index + 1, ++num_events);
+        }
+        if (game.result) {
+            notifier.note_result(*make_result(*game.result, board, players));
+            replay_messages(game_index + 1, ++num_events);
+        }
+    }
+}
+
+std::string BufferedNotifier::to_string() const
+{
+    auto notifier = StringNotifier{};
+    replay(notifier);
+    return std::move(notifier.output);
+}
+
+void BufferedNotifier::clear()
+{
+    games.clear();
+    messages.clear();
+}
+
+} // namespace reviser
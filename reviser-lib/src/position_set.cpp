@@ -0,0 +1,17 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "position_set.hpp"
+
+#include <ostream>
+
+std::ostream& reviser::operator<<(std::ostream& os, const PositionSet positions)
+{
+    os << "PositionSet{";
+    auto separator = "";
+    for (const auto pos : positions) {
+        os << separator << pos;
+        separator = ", ";
+    }
+    os << "}";
+    return os;
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "wthor.hpp"
+
+#include <string>
+
+namespace reviser {
+
+Position wthor_move_to_position(const std::uint8_t move)
+{
+    const auto row = move / 10;
+    const auto column = move % 10;
+    if (row < 1 || row > 8 || column < 1 || column > 8) {
+        throw std::invalid_argument("Invalid WTHOR move " + std::to_string(move) + ".");
+    }
+    return Position{Row{row - 1}, Column{8 - column}};
+}
+
+std::uint8_t position_to_wthor_move(const Position pos)
+{
+    return static_cast<std::uint8_t>(10 * (pos.get_row() + 1) + (8 - pos.get_column()));
+}
+
+std::size_t WthorGame::get_num_moves() const
+{
+    auto num_moves = std::size_t{0};
+    while (num_moves < wthor_max_num_moves && bytes[8 + num_moves] != 0) {
+        ++num_moves;
+    }
+    return num_moves;
+}
+
+WthorDatabase::WthorDatabase(const std::filesystem::path& path)
+    : mapped_file{std::in_place, path}
+    , data{mapped_file->get_data()}
+{
+    validate();
+}
+
+WthorDatabase::WthorDatabase(const std::span<const std::uint8_t> data)
+    : data{data}
+{
+    validate();
+}
+
+WthorGame WthorDatabase::at(const std::size_t index) const
+{
+    if (index >= num_games) {
+        throw std::invalid_argument("WTHOR game index out of range.");
+    }
+    return (*this)[index];
+}
+
+void WthorDatabase::validate()
+{
+    if (data.size() < wthor_header_size) {
+        throw std::invalid_argument("WTHOR file is too short.");
+    }
+    const auto board_size = data[12];
+    if (board_size != 0 && board_size != 8) {
+        throw std::invalid_argument("Only WTHOR files for 8x8 boards are supported.");
+    }
+    const auto declared_num_games = static_cast<std::size_t>(
+        data[4] | data[5] << 8 | data[6] << 16 | static_cast<std::uint32_t>(data[7]) << 24);
+    num_games = (data.size() - wthor_header_size) / wthor_game_size;
+    if (declared_num_games > num_games) {
+        throw std::invalid_argument("WTHOR file is truncated.");
+    }
+    num_games = declared_num_games;
+}
+
+} // namespace reviser
@@ -0,0 +1,97 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "board.hpp"
+#include "perft.hpp"
+
+using reviser::ArrayBoard;
+using reviser::BitBoard;
+using reviser::BoardType;
+using reviser::find_perft_reference_count;
+using reviser::perft;
+using reviser::PlayerColor;
+
+namespace {
+
+constexpr auto usage = "Usage: reviser-perft [--depth N] [--board array|bit|all]\n";
+
+// Runs perft for all depths up to `max_depth` and prints the results. Returns false
+// if a count differs from the reference count.
+template <BoardType BoardT>
+bool run_perft(const std::string_view board_name, const int max_depth)
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto all_counts_match = true;
+    auto board = BoardT{};
+    board.initialize();
+    for (auto depth = 1; depth <= max_depth; ++depth) {
+        const auto start_time = Clock::now();
+        const auto nodes = perft(board, PlayerColor::dark, depth);
+        const auto seconds = std::chrono::duration<double>{Clock::now() - start_time}.count();
+        const auto nodes_per_second = seconds > 0.0 ? static_cast<double>(nodes) / seconds : 0.0;
+
+        const char* status = "unknown";
+        if (const auto reference = find_perft_reference_count(depth)) {
+            status = nodes == *reference ? "ok" : "MISMATCH";
+            all_counts_match = all_counts_match && nodes == *reference;
+        }
+        std::printf(
+            "%-5s depth %2d: %15llu nodes %9.3fs %14.0f nodes/s  %s\n",
+            board_name.data(),
+            depth,
+            static_cast<unsigned long long>(nodes),
+            seconds,
+            nodes_per_second,
+            status);
+        std::fflush(stdout);
+    }
+    return all_counts_match;
+}
+
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    auto max_depth = 9;
+    auto board_type = std::string_view{"all"};
+    for (auto i = 1; i < argc; ++i) {
+        const auto arg = std::string_view{argv[i]};
+        if ((arg == "--depth" || arg == "-d") && i + 1 < argc) {
+            const auto value = std::string_view{argv[++i]};
+            const auto [end, error]
+                = std::from_chars(value.data(), value.data() + value.size(), max_depth);
+            if (error != std::errc{} || end != value.data() + value.size() || max_depth < 1) {
+                std::fputs(usage, stderr);
+                return 1;
+            }
+        }
+        else if ((arg == "--board" || arg == "-b") && i + 1 < argc) {
+            board_type = argv[++i];
+        }
+        else {
+            std::fputs(usage, stderr);
+            return 1;
+        }
+    }
+
+    auto all_counts_match = true;
+    if (board_type == "array" || board_type == "all") {
+        all_counts_match = run_perft<ArrayBoard>("array", max_depth) && all_counts_match;
+    }
+    if (board_type == "bit" || board_type == "all") {
+        all_counts_match = run_perft<BitBoard>("bit", max_depth) && all_counts_match;
+    }
+    if (board_type != "array" && board_type != "bit" && board_type != "all") {
+        std::fputs(usage, stderr);
+        return 1;
+    }
+    return all_counts_match ? 0 : 2;
+}
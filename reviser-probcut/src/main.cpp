@@ -0,0 +1,296 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "bit_board.hpp"
+#include "game_record.hpp"
+#include "pattern_evaluator.hpp"
+#include "probcut.hpp"
+#include "search.hpp"
+#include "wthor.hpp"
+
+using reviser::BitBoard;
+using reviser::game_record_pass;
+using reviser::GameRecord;
+using reviser::GameRecordReader;
+using reviser::PlayerColor;
+using reviser::Position;
+using reviser::WthorDatabase;
+using reviser::ai::AlphaBetaSearch;
+using reviser::ai::PatternEvaluator;
+using reviser::ai::PatternWeights;
+using reviser::ai::ProbCutParameters;
+using reviser::ai::ProbCutSample;
+using reviser::ai::SearchLimits;
+using reviser::ai::TranspositionTable;
+
+namespace {
+
+constexpr auto usage
+    = "Usage: reviser-probcut [--stages N] [--max-depth N] [--every N] [--positions N]\n"
+      "                       [--threads N] [--weights FILE] [--output FILE] INPUT...\n"
+      "Inputs ending in .wtb are read as WTHOR databases, all others as game records.\n";
+
+struct CalibrationConfig
+{
+    std::size_t num_stages{4};
+    int max_depth{8};
+    // Every n-th position of each game is used.
+    std::size_t position_interval{4};
+    std::size_t max_positions{2000};
+    std::size_t num_threads{std::max(std::thread::hardware_concurrency(), 1u)};
+};
+
+struct StoredPosition
+{
+    BitBoard board;
+    PlayerColor pc;
+};
+
+bool is_wthor_file(const std::filesystem::path& path)
+{
+    auto extension = path.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](const unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return extension == ".wtb";
+}
+
+// Collects the positions before every `config.position_interval`-th move of each
+// game, as long as they have more empty fields than the deepest search needs.
+class PositionCollector
+{
+public:
+    explicit PositionCollector(const CalibrationConfig& config)
+        : config{config}
+    {}
+
+    [[nodiscard]] bool is_full() const { return positions.size() >= config.max_positions; }
+
+    void start_game()
+    {
+        board.initialize();
+        num_moves = 0;
+    }
+
+    void play_move(const PlayerColor pc, const Position pos)
+    {
+        if (!board.is_valid_move(pc, pos)) {
+            throw std::invalid_argument("Game contains an invalid move.");
+        }
+        if (num_moves++ % config.position_interval == 0 && !is_full()
+            && board.compute_score().get_num_empty_fields() > config.max_depth) {
+            positions.push_back({board, pc});
+        }
+        board.play_move(pc, pos);
+    }
+
+    [[nodiscard]] const BitBoard& get_board() const { return board; }
+
+    [[nodiscard]] const std::vector<StoredPosition>& get_positions() const { return positions; }
+
+private:
+    const CalibrationConfig& config;
+    std::vector<StoredPosition> positions{};
+    BitBoard board{};
+    std::size_t num_moves{};
+};
+
+void add_games(PositionCollector& collector, const std::filesystem::path& path)
+{
+    if (is_wthor_file(path)) {
+        const auto database = WthorDatabase{path};
+        for (const auto game : database.get_games()) {
+            if (collector.is_full()) {
+                return;
+            }
+            collector.start_game();
+            auto pc = PlayerColor::dark;
+            for (const auto pos : game.get_moves()) {
+                // WTHOR games do not record passes.
+                if (!collector.get_board().is_valid_move(pc, pos)) {
+                    pc = other_player_color(pc);
+                }
+                collector.play_move(pc, pos);
+                pc = other_player_color(pc);
+            }
+        }
+    }
+    else {
+        auto in = std::ifstream{path, std::ios::binary};
+        if (!in) {
+            throw std::invalid_argument("Could not open " + path.string() + ".");
+        }
+        auto reader = GameRecordReader{in};
+        for (auto record = GameRecord{}; !collector.is_full() && reader.read_next(record);) {
+            collector.start_game();
+            auto pc = PlayerColor::dark;
+            for (const auto move : record.moves) {
+                if (move != game_record_pass) {
+                    collector.play_move(pc, Position::from_linear_index(move));
+                }
+                pc = other_player_color(pc);
+            }
+        }
+    }
+}
+
+// Searches every position to all depths up to `config.max_depth` without ProbCut.
+std::vector<ProbCutSample> compute_samples(
+    const std::vector<StoredPosition>& positions,
+    const CalibrationConfig& config,
+    const std::shared_ptr<const PatternWeights>& weights)
+{
+    auto samples = std::vector<ProbCutSample>(positions.size());
+    auto next_position = std::atomic<std::size_t>{0};
+    auto num_finished = std::atomic<std::size_t>{0};
+    {
+        auto workers = std::vector<std::jthread>{};
+        for (std::size_t i = 0; i < config.num_threads; ++i) {
+            workers.emplace_back([&] {
+                auto search = AlphaBetaSearch<BitBoard, PatternEvaluator>{
+                    SearchLimits{},
+                    std::make_shared<TranspositionTable>(16),
+                    PatternEvaluator{weights}};
+                auto evaluator = PatternEvaluator{weights};
+                for (auto j = next_position++; j < positions.size(); j = next_position++) {
+                    const auto& [board, pc] = positions[j];
+                    auto& sample = samples[j];
+                    sample.num_discs = 64 - board.compute_score().get_num_empty_fields();
+                    evaluator.set_board(board);
+                    sample.values.push_back(evaluator.evaluate(board, pc));
+                    for (auto depth = 1; depth <= config.max_depth; ++depth) {
+                        search.set_limits({.max_depth = depth});
+                        sample.values.push_back(search.search(board, pc).score);
+                    }
+                    if (const auto finished = ++num_finished; finished % 100 == 0) {
+                        std::printf("Searched %zu of %zu positions\n", finished, positions.size());
+                        std::fflush(stdout);
+                    }
+                }
+            });
+        }
+    }
+    return samples;
+}
+
+template <typename T>
+bool parse_value(const std::string_view value, T& result)
+{
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    return error == std::errc{} && end == value.data() + value.size();
+}
+
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    auto config = CalibrationConfig{};
+    auto weights = PatternWeights::get_default();
+    auto weights_file = std::filesystem::path{};
+    auto output = std::filesystem::path{"probcut.txt"};
+    auto inputs = std::vector<std::filesystem::path>{};
+    for (auto i = 1; i < argc; ++i) {
+        const auto arg = std::string_view{argv[i]};
+        const auto has_value = i + 1 < argc;
+        auto is_valid = true;
+        if ((arg == "--stages" || arg == "-s") && has_value) {
+            is_valid = parse_value(argv[++i], config.num_stages);
+        }
+        else if ((arg == "--max-depth" || arg == "-d") && has_value) {
+            is_valid = parse_value(argv[++i], config.max_depth);
+        }
+        else if (arg == "--every" && has_value) {
+            is_valid = parse_value(argv[++i], config.position_interval)
+                       && config.position_interval > 0;
+        }
+        else if ((arg == "--positions" || arg == "-n") && has_value) {
+            is_valid = parse_value(argv[++i], config.max_positions);
+        }
+        else if ((arg == "--threads" || arg == "-t") && has_value) {
+            is_valid = parse_value(argv[++i], config.num_threads) && config.num_threads > 0;
+        }
+        else if ((arg == "--weights" || arg == "-w") && has_value) {
+            weights_file = argv[++i];
+        }
+        else if ((arg == "--output" || arg == "-o") && has_value) {
+            output = argv[++i];
+        }
+        else if (!arg.starts_with("-")) {
+            inputs.emplace_back(arg);
+        }
+        else {
+            is_valid = false;
+        }
+        if (!is_valid) {
+            std::fputs(usage, stderr);
+            return 1;
+        }
+    }
+    if (inputs.empty()) {
+        std::fputs(usage, stderr);
+        return 1;
+    }
+
+    try {
+        // Fails early for invalid settings, before the searches.
+        static_cast<void>(ProbCutParameters{config.num_stages, config.max_depth});
+        if (!weights_file.empty()) {
+            weights = std::make_shared<const PatternWeights>(PatternWeights::load(weights_file));
+        }
+
+        auto collector = PositionCollector{config};
+        for (const auto& input : inputs) {
+            add_games(collector, input);
+        }
+        const auto& positions = collector.get_positions();
+        std::printf(
+            "Searching %zu positions to depth %d on %zu threads\n",
+            positions.size(),
+            config.max_depth,
+            config.num_threads);
+
+        const auto start_time = std::chrono::steady_clock::now();
+        const auto samples = compute_samples(positions, config, weights);
+        const auto parameters
+            = fit_probcut_parameters(samples, config.num_stages, config.max_depth);
+        parameters.save(output);
+        std::printf(
+            "Fitted ProbCut parameters in %.3fs and wrote them to %s\n",
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count(),
+            output.string().c_str());
+        for (std::size_t stage = 0; stage < config.num_stages; ++stage) {
+            for (auto depth = ProbCutParameters::min_depth; depth <= config.max_depth; ++depth) {
+                const auto& regression = parameters.get_regression(stage, depth);
+                std::printf(
+                    "Stage %zu, depth %2d from %d: slope %.3f, intercept %+.1f, sigma %.1f\n",
+                    stage,
+                    depth,
+                    ProbCutParameters::get_shallow_depth(depth),
+                    regression.slope,
+                    regression.intercept,
+                    regression.sigma);
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "game_record.hpp"
+#include "pattern_training.hpp"
+#include "wthor.hpp"
+
+using reviser::GameRecord;
+using reviser::GameRecordReader;
+using reviser::WthorDatabase;
+using reviser::ai::TrainingConfig;
+using reviser::ai::TrainingSet;
+
+namespace {
+
+constexpr auto usage
+    = "Usage: reviser-train [--phases N] [--epochs N] [--learning-rate X] [--threads N]\n"
+      "                     [--output FILE] INPUT...\n"
+      "Inputs ending in .wtb are read as WTHOR databases, all others as game records.\n";
+
+bool is_wthor_file(const std::filesystem::path& path)
+{
+    auto extension = path.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](const unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return extension == ".wtb";
+}
+
+// Adds all games in `path` to `training_set` and returns their number.
+std::size_t add_games(TrainingSet& training_set, const std::filesystem::path& path)
+{
+    auto num_games = std::size_t{0};
+    if (is_wthor_file(path)) {
+        const auto database = WthorDatabase{path};
+        training_set.reserve(training_set.size() + database.size() * 60);
+        for (const auto game : database.get_games()) {
+            training_set.add_game(game);
+            ++num_games;
+        }
+    }
+    else {
+        auto in = std::ifstream{path, std::ios::binary};
+        if (!in) {
+            throw std::invalid_argument("Could not open " + path.string() + ".");
+        }
+        auto reader = GameRecordReader{in};
+        for (auto record = GameRecord{}; reader.read_next(record);) {
+            training_set.add_game(record);
+            ++num_games;
+        }
+    }
+    return num_games;
+}
+
+template <typename T>
+bool parse_value(const std::string_view value, T& result)
+{
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    return error == std::errc{} && end == value.data() + value.size();
+}
+
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    auto config = TrainingConfig{};
+    auto output = std::filesystem::path{"weights.bin"};
+    auto inputs = std::vector<std::filesystem::path>{};
+    for (auto i = 1; i < argc; ++i) {
+        const auto arg = std::string_view{argv[i]};
+        const auto has_value = i + 1 < argc;
+        auto is_valid = true;
+        if ((arg == "--phases" || arg == "-p") && has_value) {
+            is_valid = parse_value(argv[++i], config.num_phases);
+        }
+        else if ((arg == "--epochs" || arg == "-e") && has_value) {
+            is_valid = parse_value(argv[++i], config.num_epochs);
+        }
+        else if ((arg == "--learning-rate" || arg == "-l") && has_value) {
+            is_valid = parse_value(argv[++i], config.learning_rate);
+        }
+        else if ((arg == "--threads" || arg == "-t") && has_value) {
+            is_valid = parse_value(argv[++i], config.num_threads);
+        }
+        else if ((arg == "--output" || arg == "-o") && has_value) {
+            output = argv[++i];
+        }
+        else if (!arg.starts_with("-")) {
+            inputs.emplace_back(arg);
+        }
+        else {
+            is_valid = false;
+        }
+        if (!is_valid) {
+            std::fputs(usage, stderr);
+            return 1;
+        }
+    }
+    if (inputs.empty()) {
+        std::fputs(usage, stderr);
+        return 1;
+    }
+
+    try {
+        const auto start_time = std::chrono::steady_clock::now();
+        auto training_set = TrainingSet{};
+        auto num_games = std::size_t{0};
+        for (const auto& input : inputs) {
+            num_games += add_games(training_set, input);
+        }
+        const auto extraction_time
+            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time);
+        std::printf(
+            "Extracted %zu positions from %zu games in %.3fs (%.0f positions/s)\n",
+            training_set.size(),
+            num_games,
+            extraction_time.count(),
+            static_cast<double>(training_set.size()) / extraction_time.count());
+
+        const auto weights = train_pattern_weights(
+            training_set, config, [](const std::size_t epoch, const double mean_squared_error) {
+                std::printf("Epoch %4zu: mean squared error %.3f\n", epoch, mean_squared_error);
+                std::fflush(stdout);
+            });
+        weights.save(output);
+        std::printf(
+            "Wrote weights for %zu phases to %s\n",
+            weights.get_num_phases(),
+            output.string().c_str());
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
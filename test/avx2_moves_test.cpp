@@ -0,0 +1,80 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "avx2_moves.hpp"
+
+#include <bit>
+#include <random>
+
+#include "bit_board.hpp"
+#include "doctest.hpp"
+
+using reviser::BitBoard;
+using reviser::Bits;
+using reviser::find_flip_bits;
+using reviser::find_flip_bits_avx2;
+using reviser::find_move_bits;
+using reviser::find_move_bits_avx2;
+using reviser::has_avx2_support;
+using reviser::other_player_color;
+using reviser::PlayerColor;
+using reviser::Position;
+
+TEST_CASE("find_move_bits_avx2() and find_flip_bits_avx2() agree with the scalar versions.")
+{
+    if (!has_avx2_support()) {
+        MESSAGE("AVX2 is not supported, skipping.");
+        return;
+    }
+
+    SUBCASE("on arbitrary disc patterns")
+    {
+        auto rng = std::mt19937_64{25};
+        for (auto i = 0; i < 10'000; ++i) {
+            const auto occupied = rng() | rng();
+            const auto player = occupied & rng();
+            const auto opponent = occupied & ~player;
+            const auto moves = find_move_bits(player, opponent);
+            REQUIRE(find_move_bits_avx2(player, opponent) == moves);
+            for (auto empty = ~occupied; empty != 0; empty &= empty - 1) {
+                const auto move = Bits{1} << std::countr_zero(empty);
+                REQUIRE(
+                    find_flip_bits_avx2(player, opponent, move)
+                    == find_flip_bits(player, opponent, move));
+            }
+        }
+    }
+
+    SUBCASE("in random games")
+    {
+        auto rng = std::mt19937{25};
+        for (auto game = 0; game < 200; ++game) {
+            auto board = BitBoard{};
+            board.initialize();
+            auto pc = PlayerColor::dark;
+            for (auto num_passes = 0; num_passes < 2; pc = other_player_color(pc)) {
+                const auto& b = board;
+                const auto player = b.get_bits_for(pc);
+                const auto opponent = b.get_bits_for(other_player_color(pc));
+                const auto moves = find_move_bits(player, opponent);
+                REQUIRE(find_move_bits_avx2(player, opponent) == moves);
+                if (moves == 0) {
+                    ++num_passes;
+                    continue;
+                }
+                num_passes = 0;
+                for (auto rest = moves; rest != 0; rest &= rest - 1) {
+                    const auto move = Bits{1} << std::countr_zero(rest);
+                    REQUIRE(
+                        find_flip_bits_avx2(player, opponent, move)
+                        == find_flip_bits(player, opponent, move));
+                }
+                auto move_index = static_cast<int>(rng() % std::popcount(moves));
+                auto rest = moves;
+                for (; move_index > 0; --move_index) {
+                    rest &= rest - 1;
+                }
+                board.play_move(pc, Position::from_linear_index(std::countr_zero(rest)));
+            }
+        }
+    }
+}
@@ -0,0 +1,253 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "bit_board.hpp"
+
+#include <random>
+#include <vector>
+
+#include "array_board.hpp"
+#include "doctest.hpp"
+
+using reviser::all_board_positions;
+using reviser::ArrayBoard;
+using reviser::BitBoard;
+using reviser::Column;
+using reviser::Field;
+using reviser::InitialBoardState;
+using reviser::other_player_color;
+using reviser::PlayerColor;
+using reviser::Position;
+using reviser::PositionSet;
+using reviser::Row;
+
+TEST_CASE("BitBoard::from_string() and BitBoard::to_string()")
+{
+    const auto board_str = "|O|*| | |O|*| | |\n"
+                           "|O|*| | |O|*| |*|\n"
+                           "|O|*| | |O|*| | |\n"
+                           "|O|*| | |O|*| | |\n"
+                           "|O|*| | |O|*| | |\n"
+                           "|O|*| | |O|*| | |\n"
+                           "|O|*| | |O|*| | |\n"
+                           "|O|*| | |O|*| |O|";
+    const auto board = BitBoard::from_string(board_str);
+
+    CHECK(board[Position{Row{0}, Column{0}}] == Field::light);
+    CHECK(board[Position{Row{0}, Column{1}}] == Field::dark);
+    CHECK(board[Position{Row{0}, Column{2}}] == Field::empty);
+    CHECK(board[Position{Row{1}, Column{7}}] == Field::dark);
+    CHECK(board[Position{Row{7}, Column{7}}] == Field::light);
+    CHECK(board.to_string() == std::string{board_str});
+}
+
+TEST_CASE("BitBoard::operator[] can be assigned to")
+{
+    auto board = BitBoard{};
+    const auto pos = Position{Row{2}, Column{5}};
+
+    board[pos] = Field::dark;
+    CHECK(std::as_const(board)[pos] == Field::dark);
+    board[pos] = Field::light;
+    CHECK(std::as_const(board)[pos] == Field::light);
+    board[pos] = Field::empty;
+    CHECK(board.is_empty(pos));
+}
+
+TEST_CASE("BitBoard::initialize()")
+{
+    auto board = BitBoard::from_string("|O|*| | |O|*| | |\n"
+                                       "|O|*| | |O|*| |*|\n"
+                                       "|O|*| | |O|*| | |\n"
+                                       "|O|*| | |O|*| | |\n"
+                                       "|O|*| | |O|*| | |\n"
+                                       "|O|*| | |O|*| | |\n"
+                                       "|O|*| | |O|*| | |\n"
+                                       "|O|*| | |O|*| |O|");
+
+    SUBCASE("InitialBoardState::empty sets all fields to empty")
+    {
+        board.initialize(InitialBoardState::empty);
+        for (auto field : board) {
+            CHECK(field == Field::empty);
+        }
+    }
+
+    SUBCASE("InitialBoardState::center_square matches ArrayBoard")
+    {
+        auto array_board = ArrayBoard{};
+        array_board.initialize(InitialBoardState::center_square);
+        board.initialize(InitialBoardState::center_square);
+        CHECK(board.to_string() == array_board.to_string());
+    }
+}
+
+TEST_CASE("BitBoard::find_valid_moves() against board with occupied corner.")
+{
+    const auto board = BitBoard::from_string("|*|O|O|O| | | | |\n"
+                                             "| |*| | | | | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | |*|O| | | |\n"
+                                             "| | | |O|*| | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | | | | | | |");
+
+    SUBCASE("Light has six moves.")
+    {
+        const auto valid_moves = PositionSet{
+            Position{Row{2}, Column{0}},
+            Position{Row{2}, Column{1}},
+            Position{Row{2}, Column{3}},
+            Position{Row{3}, Column{2}},
+            Position{Row{4}, Column{5}},
+            Position{Row{5}, Column{4}}};
+        CHECK(board.find_valid_moves(PlayerColor::light) == valid_moves);
+    }
+
+    SUBCASE("Dark has five moves.")
+    {
+        const auto valid_moves = PositionSet{
+            Position{Row{0}, Column{4}},
+            Position{Row{2}, Column{4}},
+            Position{Row{3}, Column{5}},
+            Position{Row{4}, Column{2}},
+            Position{Row{5}, Column{3}}};
+        CHECK(board.find_valid_moves(PlayerColor::dark) == valid_moves);
+    }
+}
+
+TEST_CASE("BitBoard::find_valid_moves() does not wrap around rows.")
+{
+    const auto board = BitBoard::from_string("| | | | | | |*|O|\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "|O|*| | | | | | |");
+
+    CHECK(board.find_valid_moves(PlayerColor::dark).empty());
+    CHECK(
+        board.find_valid_moves(PlayerColor::light)
+        == PositionSet{Position{Row{0}, Column{5}}, Position{Row{7}, Column{2}}});
+}
+
+TEST_CASE("BitBoard::play_move()")
+{
+    auto board = BitBoard::from_string("|*|O|O|O| | | | |\n"
+                                       "| |*| | | | | | |\n"
+                                       "| | | | | | | | |\n"
+                                       "| | | |*|O| | | |\n"
+                                       "| | | |O|*| | | |\n"
+                                       "| | | | | | | | |\n"
+                                       "| | | | | | | | |\n"
+                                       "| | | | | | | | |");
+
+    SUBCASE("Dark player plays (0, 4).")
+    {
+        board.play_move(PlayerColor::dark, Position{Row{0}, Column{4}});
+
+        auto expected = BitBoard::from_string("|*|*|*|*|*| | | |\n"
+                                              "| |*| | | | | | |\n"
+                                              "| | | | | | | | |\n"
+                                              "| | | |*|O| | | |\n"
+                                              "| | | |O|*| | | |\n"
+                                              "| | | | | | | | |\n"
+                                              "| | | | | | | | |\n"
+                                              "| | | | | | | | |");
+        CHECK(board == expected);
+    }
+
+    SUBCASE("Light player plays (2, 0).")
+    {
+        board.play_move(PlayerColor::light, Position{Row{2}, Column{0}});
+
+        auto expected = BitBoard::from_string("|*|O|O|O| | | | |\n"
+                                              "| |O| | | | | | |\n"
+                                              "|O| | | | | | | |\n"
+                                              "| | | |*|O| | | |\n"
+                                              "| | | |O|*| | | |\n"
+                                              "| | | | | | | | |\n"
+                                              "| | | | | | | | |\n"
+                                              "| | | | | | | | |");
+        CHECK(board == expected);
+    }
+
+    SUBCASE("Invalid moves do not change the board.")
+    {
+        const auto expected = board;
+        board.play_move(PlayerColor::light, Position{Row{7}, Column{7}});
+        board.play_move(PlayerColor::light, Position{Row{0}, Column{1}});
+        CHECK(board == expected);
+    }
+}
+
+TEST_CASE("BitBoard::undo_move() restores the board.")
+{
+    auto rng = std::mt19937{7};
+    auto board = BitBoard{};
+    board.initialize();
+    auto records = std::vector<reviser::FlipRecord>{};
+    auto boards = std::vector<BitBoard>{};
+    auto pc = PlayerColor::dark;
+
+    for (auto ply = 0; ply < 60; ++ply) {
+        const auto moves = board.find_valid_moves(pc);
+        if (!moves.empty()) {
+            const auto move_vector = std::vector<Position>{moves.begin(), moves.end()};
+            boards.push_back(board);
+            records.push_back(board.play_move(pc, move_vector[rng() % moves.size()]));
+            REQUIRE(records.back().was_played());
+        }
+        pc = other_player_color(pc);
+    }
+
+    while (!records.empty()) {
+        board.undo_move(records.back());
+        CHECK(board == boards.back());
+        records.pop_back();
+        boards.pop_back();
+    }
+}
+
+TEST_CASE("BitBoard agrees with ArrayBoard on random games.")
+{
+    auto rng = std::mt19937{42};
+
+    for (auto game = 0; game < 20; ++game) {
+        auto bit_board = BitBoard{};
+        auto array_board = ArrayBoard{};
+        bit_board.initialize();
+        array_board.initialize();
+        auto pc = PlayerColor::dark;
+        auto num_passes = 0;
+
+        while (num_passes < 2) {
+            const auto moves = bit_board.find_valid_moves(pc);
+            REQUIRE(moves == array_board.find_valid_moves(pc));
+            for (auto pos : all_board_positions()) {
+                CHECK(bit_board.is_valid_move(pc, pos) == moves.contains(pos));
+            }
+            if (moves.empty()) {
+                ++num_passes;
+            }
+            else {
+                num_passes = 0;
+                auto move_vector = std::vector<Position>{moves.begin(), moves.end()};
+                const auto move = move_vector[rng() % move_vector.size()];
+                const auto bit_record = bit_board.play_move(pc, move);
+                const auto array_record = array_board.play_move(pc, move);
+                CHECK(bit_record.flipped_positions == array_record.flipped_positions);
+                REQUIRE(bit_board.to_string() == array_board.to_string());
+            }
+            pc = other_player_color(pc);
+        }
+
+        const auto bit_score = bit_board.compute_score();
+        const auto array_score = array_board.compute_score();
+        CHECK(bit_score.get_num_dark_fields() == array_score.get_num_dark_fields());
+        CHECK(bit_score.get_num_light_fields() == array_score.get_num_light_fields());
+        CHECK(bit_score.get_num_empty_fields() == array_score.get_num_empty_fields());
+    }
+}
@@ -1,6 +1,11 @@
 // Copyright (c) 2021-2022 Dr. Matthias Hölzl.
 
 #include "array_board.hpp"
+
+#include <set>
+#include <tuple>
+#include <vector>
+
 #include "doctest.hpp"
 
 using reviser::all_board_positions;
@@ -11,6 +16,7 @@ using reviser::Field;
 using reviser::InitialBoardState;
 using reviser::PlayerColor;
 using reviser::Position;
+using reviser::PositionSet;
 using reviser::Row;
 
 TEST_CASE("ArrayBoard::from_string()")
@@ -152,7 +158,7 @@ TEST_CASE("ArrayBoard::is_valid_move()")
 }
 
 void check_valid_moves(
-    const ArrayBoard& board, PlayerColor pc, const std::set<Position>& valid_moves)
+    const ArrayBoard& board, PlayerColor pc, const PositionSet valid_moves)
 {
     for (auto pos : all_board_positions()) {
         auto result = board.is_valid_move(pc, pos);
@@ -173,7 +179,7 @@ TEST_CASE("ArrayBoard::is_valid_moves() for initial board (alternative test "
 
     SUBCASE("Light has four moves.")
     {
-        const auto valid_moves = std::set<Position>{
+        const auto valid_moves = PositionSet{
             Position{Row{2}, Column{3}},
             Position{Row{3}, Column{2}},
             Position{Row{4}, Column{5}},
@@ -183,7 +189,7 @@ TEST_CASE("ArrayBoard::is_valid_moves() for initial board (alternative test "
 
     SUBCASE("Dark has four moves.")
     {
-        const auto valid_moves = std::set<Position>{
+        const auto valid_moves = PositionSet{
             Position{Row{2}, Column{4}},
             Position{Row{3}, Column{5}},
             Position{Row{4}, Column{2}},
@@ -199,7 +205,7 @@ TEST_CASE("ArrayBoard::find_valid_moves() against initial board.")
 
     SUBCASE("Light has four moves.")
     {
-        const auto valid_moves = std::set<Position>{
+        const auto valid_moves = PositionSet{
             Position{Row{2}, Column{3}},
             Position{Row{3}, Column{2}},
             Position{Row{4}, Column{5}},
@@ -209,7 +215,7 @@ TEST_CASE("ArrayBoard::find_valid_moves() against initial board.")
 
     SUBCASE("Dark has four moves.")
     {
-        const auto valid_moves = std::set<Position>{
+        const auto valid_moves = PositionSet{
             Position{Row{2}, Column{4}},
             Position{Row{3}, Column{5}},
             Position{Row{4}, Column{2}},
@@ -233,7 +239,7 @@ TEST_CASE("ArrayBoard::find_valid_moves() against board with occupied corner.")
 
     SUBCASE("Light has six moves.")
     {
-        const auto valid_moves = std::set<Position>{
+        const auto valid_moves = PositionSet{
             Position{Row{2}, Column{0}},
             Position{Row{2}, Column{1}},
             Position{Row{2}, Column{3}},
@@ -245,7 +251,7 @@ TEST_CASE("ArrayBoard::find_valid_moves() against board with occupied corner.")
 
     SUBCASE("Dark has five moves.")
     {
-        const auto valid_moves = std::set<Position>{
+        const auto valid_moves = PositionSet{
             Position{Row{0}, Column{4}},
             Position{Row{2}, Column{4}},
             Position{Row{3}, Column{5}},
@@ -449,3 +455,143 @@ TEST_CASE("BoardReader<ArrayBoard>::convert_char()")
     CHECK(BoardReader<ArrayBoard>::convert_char(' ') == Field::empty);
     CHECK_THROWS_AS(BoardReader<ArrayBoard>::convert_char('a'), std::invalid_argument);
 }
+
+TEST_CASE("ArrayBoard only flips fields up to the nearest field of the player.")
+{
+    auto board = ArrayBoard::from_string("| | | | | | | | |\n"
+                                         "| | | | | | | | |\n"
+                                         "| | | | | | | | |\n"
+                                         "| | | |*|*|*| | |\n"
+                                         "| |O|O|*|O| | | |\n"
+                                         "| | |*| |O| | | |\n"
+                                         "| | | | | | | | |\n"
+                                         "| | | | | | | | |");
+
+    CHECK_FALSE(board.is_valid_move(PlayerColor::light, Position{Row{4}, Column{0}}));
+
+    board.play_move(PlayerColor::dark, Position{Row{4}, Column{0}});
+    CHECK(board[Position{Row{4}, Column{0}}] == Field::dark);
+    CHECK(board[Position{Row{4}, Column{1}}] == Field::dark);
+    CHECK(board[Position{Row{4}, Column{2}}] == Field::dark);
+    CHECK(board[Position{Row{4}, Column{4}}] == Field::light);
+}
+
+TEST_CASE("ArrayBoard::undo_move()")
+{
+    const auto original = ArrayBoard::from_string("|*|O|O|O| | | | |\n"
+                                                  "| |*| | | | | | |\n"
+                                                  "| | | | | | | | |\n"
+                                                  "| | | |*|O| | | |\n"
+                                                  "| | | |O|*| | | |\n"
+                                                  "| | | | | | | | |\n"
+                                                  "| | | | | | | | |\n"
+                                                  "| | | | | | | | |");
+    auto board = original;
+
+    SUBCASE("play_move() records the flipped positions.")
+    {
+        const auto record = board.play_move(PlayerColor::dark, Position{Row{0}, Column{4}});
+        CHECK(record.was_played());
+        CHECK(record.move == Position{Row{0}, Column{4}});
+        CHECK(record.player_color == PlayerColor::dark);
+        CHECK(
+            record.flipped_positions
+            == PositionSet{
+                Position{Row{0}, Column{1}},
+                Position{Row{0}, Column{2}},
+                Position{Row{0}, Column{3}}});
+    }
+
+    SUBCASE("undo_move() restores the board for all valid moves.")
+    {
+        for (const auto pc : {PlayerColor::dark, PlayerColor::light}) {
+            for (const auto move : board.find_valid_moves(pc)) {
+                const auto record = board.play_move(pc, move);
+                CHECK_FALSE(board == original);
+                board.undo_move(record);
+                CHECK(board == original);
+            }
+        }
+    }
+
+    SUBCASE("undo_move() ignores records of rejected moves.")
+    {
+        const auto record = board.play_move(PlayerColor::dark, Position{Row{7}, Column{7}});
+        CHECK_FALSE(record.was_played());
+        board.undo_move(record);
+        CHECK(board == original);
+    }
+}
+
+namespace {
+void check_score_matches_fields(const ArrayBoard& board)
+{
+    auto num_dark = 0;
+    auto num_light = 0;
+    for (const auto field : board) {
+        num_dark += field == Field::dark;
+        num_light += field == Field::light;
+    }
+    const auto score = board.compute_score();
+    CHECK(score.get_num_dark_fields() == num_dark);
+    CHECK(score.get_num_light_fields() == num_light);
+    CHECK(score.get_num_empty_fields() == 64 - num_dark - num_light);
+}
+} // namespace
+
+TEST_CASE("ArrayBoard::compute_score() tracks all modifications.")
+{
+    auto board = ArrayBoard{};
+    check_score_matches_fields(board);
+
+    SUBCASE("initialize()")
+    {
+        board.initialize(InitialBoardState::center_square);
+        check_score_matches_fields(board);
+        CHECK(board.compute_score().get_num_dark_fields() == 2);
+        board.initialize(InitialBoardState::empty);
+        check_score_matches_fields(board);
+        CHECK(board.compute_score().get_num_empty_fields() == 64);
+    }
+
+    SUBCASE("Writes through operator[] and set_field()")
+    {
+        board[Position{Row{0}, Column{0}}] = Field::dark;
+        board[Position{Row{0}, Column{1}}] = Field::dark;
+        board[Position{Row{0}, Column{1}}] = Field::light;
+        board.set_field(Position{Row{5}, Column{5}}, Field::light);
+        board.set_field(Position{Row{0}, Column{0}}, Field::empty);
+        check_score_matches_fields(board);
+        CHECK(board.compute_score().get_num_light_fields() == 2);
+    }
+
+    SUBCASE("from_string()")
+    {
+        check_score_matches_fields(ArrayBoard::from_string("|*|O|O|O| | | | |\n"
+                                                           "| |*| | | | | | |\n"
+                                                           "| | | | | | | | |\n"
+                                                           "| | | |*|O| | | |\n"
+                                                           "| | | |O|*| | | |\n"
+                                                           "| | | | | | | | |\n"
+                                                           "| | | | | | | | |\n"
+                                                           "| | | | | | | | |"));
+    }
+
+    SUBCASE("play_move() and undo_move()")
+    {
+        board.initialize();
+        auto pc = PlayerColor::dark;
+        auto records = std::vector<reviser::FlipRecord>{};
+        for (auto moves = board.find_valid_moves(pc); !moves.empty();
+             moves = board.find_valid_moves(pc)) {
+            records.push_back(board.play_move(pc, *moves.begin()));
+            check_score_matches_fields(board);
+            pc = reviser::other_player_color(pc);
+        }
+        for (auto it = records.rbegin(); it != records.rend(); ++it) {
+            board.undo_move(*it);
+            check_score_matches_fields(board);
+        }
+        CHECK(board.compute_score().get_num_empty_fields() == 60);
+    }
+}
@@ -0,0 +1,169 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "endgame_solver.hpp"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "doctest.hpp"
+
+using namespace reviser;
+using namespace reviser::ai;
+
+namespace {
+int disc_difference(const BitBoard& board, PlayerColor pc)
+{
+    const auto score = board.compute_score();
+    return score.get_num_fields_for(pc) - score.get_num_fields_for(other_player_color(pc));
+}
+
+int solve_by_minimax(BitBoard& board, PlayerColor pc, bool opponent_passed = false)
+{
+    const auto moves = board.find_valid_moves(pc);
+    if (moves.empty()) {
+        if (opponent_passed) {
+            return disc_difference(board, pc);
+        }
+        return -solve_by_minimax(board, other_player_color(pc), true);
+    }
+    auto result = -65;
+    for (const auto move : moves) {
+        const auto record = board.play_move(pc, move);
+        result = std::max(result, -solve_by_minimax(board, other_player_color(pc)));
+        board.undo_move(record);
+    }
+    return result;
+}
+
+BitBoard random_position(std::mt19937& rng, int num_empties, PlayerColor& pc)
+{
+    auto board = BitBoard{};
+    board.initialize();
+    pc = PlayerColor::dark;
+    auto num_passes = 0;
+    while (board.compute_score().get_num_empty_fields() > num_empties && num_passes < 2) {
+        const auto moves = board.find_valid_moves(pc);
+        if (moves.empty()) {
+            ++num_passes;
+        }
+        else {
+            num_passes = 0;
+            auto it = moves.begin();
+            std::advance(it, rng() % moves.size());
+            board.play_move(pc, *it);
+        }
+        pc = other_player_color(pc);
+    }
+    return board;
+}
+} // namespace
+
+TEST_CASE("EndgameSolver computes the exact disc difference.")
+{
+    auto rng = std::mt19937{2024};
+    const auto solver = EndgameSolver{};
+    for (auto num_empties = 1; num_empties <= 9; ++num_empties) {
+        for (auto i = 0; i < 8; ++i) {
+            auto pc = PlayerColor::dark;
+            auto board = random_position(rng, num_empties, pc);
+            const auto expected = solve_by_minimax(board, pc);
+
+            const auto result = solver.solve(board, pc);
+
+            CHECK(result.disc_difference == expected);
+            if (!board.find_valid_moves(pc).empty()) {
+                REQUIRE(result.best_move.has_value());
+                auto child = board;
+                child.play_move(pc, *result.best_move);
+                CHECK(-solve_by_minimax(child, other_player_color(pc)) == expected);
+            }
+            else {
+                CHECK_FALSE(result.best_move.has_value());
+            }
+        }
+    }
+}
+
+TEST_CASE("EndgameSolver accepts any board type.")
+{
+    auto rng = std::mt19937{7};
+    auto pc = PlayerColor::dark;
+    const auto bit_board = random_position(rng, 12, pc);
+    const auto array_board = copy_board_as<ArrayBoard>(bit_board);
+    const auto solver = EndgameSolver{};
+
+    const auto bit_board_result = solver.solve(bit_board, pc);
+    const auto array_board_result = solver.solve(array_board, pc);
+
+    CHECK(bit_board_result.disc_difference == array_board_result.disc_difference);
+    CHECK(bit_board_result.best_move == array_board_result.best_move);
+    CHECK(bit_board_result.statistics.completed_depth == 12);
+}
+
+TEST_CASE("EndgameSolver scores finished games.")
+{
+    const auto board = BitBoard::from_string("|*|*|*|*|*|*|*|*|\n"
+                                             "|*|*|*|*|*|*|*|*|\n"
+                                             "|*|*|*|*|*|*|*|*|\n"
+                                             "|*|*|*|*|*|*|*|*|\n"
+                                             "|*|*|*|*|*|*|*|*|\n"
+                                             "|*|*|*|*|*|*|*|*|\n"
+                                             "|*|*|*|*|*|*|*|*|\n"
+                                             "|*|*|*|*|*|*| | |");
+    const auto result = EndgameSolver{}.solve(board, PlayerColor::light);
+
+    CHECK_FALSE(result.best_move.has_value());
+    CHECK(result.disc_difference == -62);
+}
+
+TEST_CASE("find_stable_bits() finds corners and filled edges.")
+{
+    const auto board = BitBoard::from_string("|*|*|*|*|*|*|*|*|\n"
+                                             "|*| | | | | | | |\n"
+                                             "| | | |O| | | | |\n"
+                                             "| | | |*|O| | | |\n"
+                                             "| | | |O|*| | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | | | | | | |\n"
+                                             "| | | | | | | |O|");
+    const auto dark = board.get_bits_for(PlayerColor::dark);
+    const auto light = board.get_bits_for(PlayerColor::light);
+
+    CHECK(find_stable_bits(dark, light) == (0xffULL | position_bit(Position{Row{1}, Column{0}})));
+    CHECK(find_stable_bits(light, dark) == position_bit(Position{Row{7}, Column{7}}));
+}
+
+TEST_CASE("ParallelEndgameSolver agrees with EndgameSolver.")
+{
+    auto rng = std::mt19937{2025};
+    const auto solver = EndgameSolver{};
+    for (const std::size_t num_threads : {1, 2, 4}) {
+        const auto parallel_solver = ParallelEndgameSolver{num_threads, 4};
+        for (auto num_empties = 10; num_empties <= 16; num_empties += 2) {
+            auto pc = PlayerColor::dark;
+            const auto board = random_position(rng, num_empties, pc);
+
+            const auto expected = solver.solve(board, pc);
+            const auto result = parallel_solver.solve(board, pc);
+
+            CHECK(result.disc_difference == expected.disc_difference);
+            CHECK(result.best_move.has_value() == expected.best_move.has_value());
+            CHECK(result.statistics.completed_depth == num_empties);
+            if (result.best_move) {
+                auto child = board;
+                child.play_move(pc, *result.best_move);
+                CHECK(
+                    -solver.solve(child, other_player_color(pc)).disc_difference
+                    == expected.disc_difference);
+            }
+        }
+    }
+}
+
+TEST_CASE("ParallelEndgameSolver needs at least one thread.")
+{
+    CHECK_THROWS_AS(ParallelEndgameSolver{0}, std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "game_record.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "default_game.hpp"
+#include "doctest.hpp"
+#include "random_player.hpp"
+
+namespace reviser {
+
+using ai::RandomPlayer;
+
+namespace {
+
+bool scores_are_equal(const Score& lhs, const Score& rhs)
+{
+    return lhs.get_num_dark_fields() == rhs.get_num_dark_fields()
+           && lhs.get_num_light_fields() == rhs.get_num_light_fields()
+           && lhs.get_num_empty_fields() == rhs.get_num_empty_fields();
+}
+
+} // namespace
+
+TEST_CASE("GameRecordWriter and GameRecordReader")
+{
+    constexpr auto num_games = 20;
+    auto stream = std::stringstream{};
+    auto writer = std::make_unique<GameRecordWriter>(stream);
+    auto* writer_ptr = writer.get();
+    auto game = DefaultGame<BitBoard>{
+        std::make_shared<RandomPlayer>("first", 11),
+        std::make_shared<RandomPlayer>("second", 12),
+        std::move(writer)};
+    for (auto i = 0; i < num_games; ++i) {
+        writer_ptr->set_seed(i);
+        game.new_game(i > 0);
+        game.run_game_loop();
+    }
+    CHECK(writer_ptr->get_num_games_written() == num_games);
+
+    auto reader = GameRecordReader{stream};
+    auto record = GameRecord{};
+    auto num_games_read = 0;
+    while (reader.read_next(record)) {
+        CHECK(record.seed == num_games_read);
+        CHECK(record.dark_player_name == (num_games_read % 2 == 0 ? "first" : "second"));
+        CHECK(record.result_type != GameResultType::win_by_opponent_mistake);
+
+        auto array_board = ArrayBoard{};
+        replay_game_record(record, array_board);
+        CHECK(scores_are_equal(array_board.compute_score(), record.score));
+
+        auto bit_board = BitBoard{};
+        replay_game_record(record, bit_board);
+        CHECK(scores_are_equal(bit_board.compute_score(), record.score));
+        ++num_games_read;
+    }
+    CHECK(num_games_read == num_games);
+}
+
+TEST_CASE("Game records store passes")
+{
+    auto stream = std::stringstream{};
+    auto writer = GameRecordWriter{stream};
+    // Dark has to pass after the first eight moves.
+    const auto moves
+        = std::vector<std::uint8_t>{20, 21, 22, 14, 34, 23, 7, 5, game_record_pass, 19};
+    writer.write({GameResultType::win_by_score, 42, Score{0, 0, 0}, "dark", "light", moves});
+
+    auto reader = GameRecordReader{stream};
+    auto record = GameRecord{};
+    REQUIRE(reader.read_next(record));
+    CHECK(record.moves == moves);
+    CHECK(record.seed == 42);
+    CHECK(record.light_player_name == "light");
+    auto board = ArrayBoard{};
+    replay_game_record(record, board);
+    CHECK(board[Position::from_linear_index(19)] == Field::light);
+    CHECK_FALSE(reader.read_next(record));
+}
+
+TEST_CASE("GameRecordReader rejects invalid input")
+{
+    SUBCASE("missing header")
+    {
+        auto stream = std::stringstream{"not a game record"};
+        CHECK_THROWS_AS(GameRecordReader{stream}, std::invalid_argument);
+    }
+
+    SUBCASE("truncated record")
+    {
+        auto stream = std::stringstream{};
+        auto writer = GameRecordWriter{stream};
+        writer.write({GameResultType::tie, 0, Score{32, 32, 0}, "dark", "light", {37, 29}});
+        auto data = stream.str();
+        data.pop_back();
+
+        auto truncated_stream = std::stringstream{data};
+        auto reader = GameRecordReader{truncated_stream};
+        auto record = GameRecord{};
+        CHECK_THROWS_AS(reader.read_next(record), std::invalid_argument);
+    }
+
+    SUBCASE("invalid move")
+    {
+        auto record = GameRecord{};
+        record.moves = {0};
+        auto board = BitBoard{};
+        CHECK_THROWS_AS(replay_game_record(record, board), std::invalid_argument);
+    }
+}
+
+} // namespace reviser
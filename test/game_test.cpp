@@ -5,6 +5,7 @@
 #include <string>
 
 #include "array_board.hpp"
+#include "bit_board.hpp"
 #include "default_game.hpp"
 #include "doctest.hpp"
 #include "game_result.hpp"
@@ -160,59 +161,59 @@ TEST_CASE("Test game for the minimal player.")
         {"light_player", PlayerColor::light, 2, 3},
         {"dark_player", PlayerColor::dark, 1, 2},
         {"light_player", PlayerColor::light, 1, 3},
-        {"dark_player", PlayerColor::dark, 0, 1},
-        {"light_player", PlayerColor::light, 0, 3},
         {"dark_player", PlayerColor::dark, 0, 2},
-        {"light_player", PlayerColor::light, 0, 0},
-        {"dark_player", PlayerColor::dark, 2, 2},
-        {"light_player", PlayerColor::light, 2, 1},
-        {"dark_player", PlayerColor::dark, 1, 1},
-        {"light_player", PlayerColor::light, 2, 0},
-        {"dark_player", PlayerColor::dark, 1, 0},
-        {"light_player", PlayerColor::light, 2, 5},
+        {"light_player", PlayerColor::light, 0, 1},
+        {"dark_player", PlayerColor::dark, 0, 0},
+        {"light_player", PlayerColor::light, 0, 3},
+        {"dark_player", PlayerColor::dark, 0, 4},
+        {"light_player", PlayerColor::light, 1, 5},
         {"dark_player", PlayerColor::dark, 1, 4},
-        {"light_player", PlayerColor::light, 0, 4},
-        {"dark_player", PlayerColor::dark, 1, 5},
         {"light_player", PlayerColor::light, 0, 5},
         {"dark_player", PlayerColor::dark, 0, 6},
-        {"light_player", PlayerColor::light, 0, 7},
-        {"dark_player", PlayerColor::dark, 1, 6},
-        {"light_player", PlayerColor::light, 2, 6},
+        {"light_player", PlayerColor::light, 1, 6},
+        {"dark_player", PlayerColor::dark, 2, 1},
+        {"light_player", PlayerColor::light, 1, 1},
+        {"dark_player", PlayerColor::dark, 2, 0},
+        {"light_player", PlayerColor::light, 1, 0},
+        {"dark_player", PlayerColor::dark, 2, 2},
+        {"light_player", PlayerColor::light, 2, 5},
         {"dark_player", PlayerColor::dark, 1, 7},
+        {"light_player", PlayerColor::light, 0, 7},
+        {"dark_player", PlayerColor::dark, 2, 6},
         {"light_player", PlayerColor::light, 2, 7},
-        {"dark_player", PlayerColor::dark, 3, 0},
-        {"light_player", PlayerColor::light, 3, 1},
+        {"dark_player", PlayerColor::dark, 3, 5},
+        {"light_player", PlayerColor::light, 3, 0},
+        {"dark_player", PlayerColor::dark, 4, 0},
+        {"light_player", PlayerColor::light, 4, 5},
+        {"dark_player", PlayerColor::dark, 5, 2},
+        {"light_player", PlayerColor::light, 4, 2},
         {"dark_player", PlayerColor::dark, 3, 2},
-        {"light_player", PlayerColor::light, 3, 5},
+        {"light_player", PlayerColor::light, 4, 1},
+        {"dark_player", PlayerColor::dark, 4, 6},
+        {"light_player", PlayerColor::light, 5, 3},
         {"dark_player", PlayerColor::dark, 3, 6},
-        {"light_player", PlayerColor::light, 4, 0},
-        {"dark_player", PlayerColor::dark, 4, 1},
+        {"light_player", PlayerColor::light, 3, 1},
+        {"dark_player", PlayerColor::dark, 5, 1},
         {"light_player", PlayerColor::light, 3, 7},
-        {"dark_player", PlayerColor::dark, 4, 2},
-        {"light_player", PlayerColor::light, 4, 5},
         {"dark_player", PlayerColor::dark, 4, 7},
-        {"light_player", PlayerColor::light, 4, 6},
-        {"dark_player", PlayerColor::dark, 5, 0},
-        {"light_player", PlayerColor::light, 5, 1},
-        {"dark_player", PlayerColor::dark, 5, 2},
-        {"light_player", PlayerColor::light, 5, 3},
+        {"light_player", PlayerColor::light, 5, 0},
         {"dark_player", PlayerColor::dark, 5, 4},
         {"light_player", PlayerColor::light, 5, 5},
         {"dark_player", PlayerColor::dark, 5, 6},
         {"light_player", PlayerColor::light, 5, 7},
-        {"dark_player", PlayerColor::dark, 6, 2},
-        {"light_player", PlayerColor::light, 6, 0},
-        {"dark_player", PlayerColor::dark, 6, 4},
+        {"dark_player", PlayerColor::dark, 6, 0},
         {"light_player", PlayerColor::light, 6, 1},
-        {"dark_player", PlayerColor::dark, 6, 5},
+        {"dark_player", PlayerColor::dark, 6, 2},
         {"light_player", PlayerColor::light, 6, 3},
+        {"dark_player", PlayerColor::dark, 6, 4},
+        {"light_player", PlayerColor::light, 6, 5},
+        {"dark_player", PlayerColor::dark, 6, 6},
+        {"light_player", PlayerColor::light, 7, 0},
         {"dark_player", PlayerColor::dark, 7, 1},
-        {"light_player", PlayerColor::light, 6, 6},
-        {"dark_player", PlayerColor::dark, 7, 2},
-        {"light_player", PlayerColor::light, 6, 7},
-        {"dark_player", PlayerColor::dark, 7, 0},
-        {"light_player", PlayerColor::light, 7, 3},
-        {"dark_player", PlayerColor::dark, 7, 4},
+        {"light_player", PlayerColor::light, 7, 2},
+        {"dark_player", PlayerColor::dark, 7, 3},
+        {"light_player", PlayerColor::light, 7, 4},
+        {"dark_player", PlayerColor::dark, 6, 7},
         {"light_player", PlayerColor::light, 7, 5},
         {"dark_player", PlayerColor::dark, 7, 6},
         {"light_player", PlayerColor::light, 7, 7},
@@ -226,8 +227,31 @@ TEST_CASE("Test game for the minimal player.")
     }
 
     CHECK(notifier_spy_ptr->result_summary.type == "win"s);
-    CHECK(notifier_spy_ptr->result_summary.winner == PlayerColor::light);
-    CHECK(notifier_spy_ptr->result_summary.loser == PlayerColor::dark);
+    CHECK(notifier_spy_ptr->result_summary.winner == PlayerColor::dark);
+    CHECK(notifier_spy_ptr->result_summary.loser == PlayerColor::light);
+}
+
+TEST_CASE("Test games on ArrayBoard and BitBoard are identical.")
+{
+    auto play_game = []<typename BoardT>(std::type_identity<BoardT>) {
+        auto notifier_spy = std::make_unique<NotifierSpy>();
+        const auto* notifier_spy_ptr = notifier_spy.get();
+        auto game = std::make_unique<DefaultGame<BoardT>>(
+            std::make_shared<MinimalPlayer>("dark_player", PlayerColor::dark),
+            std::make_shared<MinimalPlayer>("light_player", PlayerColor::light),
+            std::move(notifier_spy));
+        game->new_game(false);
+        game->run_game_loop();
+        return std::pair{notifier_spy_ptr->moves, std::move(game)};
+    };
+
+    const auto [array_moves, array_game] = play_game(std::type_identity<ArrayBoard>{});
+    const auto [bit_moves, bit_game] = play_game(std::type_identity<BitBoard>{});
+
+    CHECK(array_moves == bit_moves);
+    CHECK(
+        std::as_const(*array_game).get_board().to_string()
+        == std::as_const(*bit_game).get_board().to_string());
 }
 
 } // namespace reviser
@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "lazy_smp_search.hpp"
+
+#include <memory>
+#include <random>
+
+#include "bit_board.hpp"
+#include "default_game.hpp"
+#include "doctest.hpp"
+#include "lazy_smp_player.hpp"
+#include "notifiers.hpp"
+#include "random_player.hpp"
+
+using namespace reviser;
+using namespace reviser::ai;
+
+namespace {
+
+BitBoard random_position(std::mt19937& rng, const int num_moves)
+{
+    auto board = BitBoard{};
+    board.initialize();
+    auto pc = PlayerColor::dark;
+    for (auto i = 0; i < num_moves; ++i) {
+        const auto moves = board.find_valid_moves(pc);
+        if (!moves.empty()) {
+            auto it = moves.begin();
+            std::advance(it, rng() % moves.size());
+            board.play_move(pc, *it);
+        }
+        pc = other_player_color(pc);
+    }
+    return board;
+}
+
+} // namespace
+
+TEST_CASE("LazySmpSearch with one thread searches like AlphaBetaSearch")
+{
+    auto rng = std::mt19937{2024};
+    for (auto i = 0; i < 5; ++i) {
+        const auto board = random_position(rng, 10 + 8 * i);
+        if (board.find_valid_moves(PlayerColor::light).empty()) {
+            continue;
+        }
+        const auto limits = SearchLimits{.max_depth = 4};
+        auto parallel_search = LazySmpSearch<BitBoard>{limits, 1};
+        auto search = AlphaBetaSearch<BitBoard>{limits, std::make_shared<TranspositionTable>()};
+        const auto parallel_result = parallel_search.search(board, PlayerColor::light);
+        const auto result = search.search(board, PlayerColor::light);
+        CHECK(parallel_result.best_move == result.best_move);
+        CHECK(parallel_result.score == result.score);
+        CHECK(parallel_result.statistics.nodes == result.statistics.nodes);
+    }
+}
+
+TEST_CASE("LazySmpSearch with several threads completes the main search")
+{
+    auto rng = std::mt19937{2025};
+    for (auto i = 0; i < 5; ++i) {
+        const auto board = random_position(rng, 10 + 8 * i);
+        if (board.find_valid_moves(PlayerColor::dark).empty()) {
+            continue;
+        }
+        auto search = LazySmpSearch<BitBoard>{SearchLimits{.max_depth = 5}, 4};
+        CHECK(search.get_num_threads() == 4);
+        const auto result = search.search(board, PlayerColor::dark);
+        REQUIRE(result.best_move.has_value());
+        CHECK(board.is_valid_move(PlayerColor::dark, *result.best_move));
+        CHECK(result.statistics.completed_depth == 5);
+        CHECK(result.statistics.nodes > 0);
+    }
+    CHECK_THROWS_AS(LazySmpSearch<BitBoard>(SearchLimits{}, 0), std::invalid_argument);
+}
+
+TEST_CASE("LazySmpPlayer plays complete games")
+{
+    auto smp_player = std::make_shared<LazySmpPlayer<BitBoard>>(
+        "smp", SearchLimits{.max_depth = 3}, 3, PlayerColor::dark);
+    auto random_player = std::make_shared<RandomPlayer>("random", 5);
+    auto game = DefaultGame<BitBoard>{smp_player, random_player, std::make_unique<NullNotifier>()};
+    game.new_game(false);
+    game.run_game_loop();
+
+    CHECK(game.get_result()->get_type() != GameResultType::win_by_opponent_mistake);
+    CHECK(smp_player->get_num_threads() == 3);
+    CHECK(smp_player->get_total_statistics().nodes >= smp_player->get_last_statistics().nodes);
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "mcts_player.hpp"
+
+#include <memory>
+
+#include "bit_board.hpp"
+#include "default_game.hpp"
+#include "doctest.hpp"
+#include "notifiers.hpp"
+#include "random_player.hpp"
+
+using namespace reviser;
+using namespace reviser::ai;
+
+namespace {
+
+BitBoard make_initial_board()
+{
+    auto board = BitBoard{};
+    board.initialize();
+    return board;
+}
+
+} // namespace
+
+TEST_CASE("MctsPlayer picks a valid move")
+{
+    for (const auto num_threads : {1, 4}) {
+        const auto player = MctsPlayer{
+            "mcts",
+            MctsLimits{.max_playouts = 2'000, .num_threads = static_cast<std::size_t>(num_threads)},
+            1,
+            PlayerColor::dark};
+        const auto board = make_initial_board();
+        CHECK(board.find_valid_moves(PlayerColor::dark).contains(player.pick_move(board)));
+
+        const auto& statistics = player.get_last_statistics();
+        CHECK(statistics.playouts == 2'000);
+        CHECK(statistics.reused_playouts == 0);
+        CHECK(statistics.num_nodes > 4);
+        CHECK(statistics.get_playouts_per_second() > 0.0);
+    }
+}
+
+TEST_CASE("MctsPlayer reuses the tree of its previous move")
+{
+    auto player = MctsPlayer{"mcts", MctsLimits{.max_playouts = 5'000}, 2, PlayerColor::dark};
+    auto board = make_initial_board();
+    board.play_move(PlayerColor::dark, player.pick_move(board));
+    board.play_move(PlayerColor::light, *board.find_valid_moves(PlayerColor::light).begin());
+
+    static_cast<void>(player.pick_move(board));
+    CHECK(player.get_last_statistics().reused_playouts > 0);
+    CHECK(player.get_total_statistics().playouts == 10'000);
+
+    player.new_game();
+    static_cast<void>(player.pick_move(make_initial_board()));
+    CHECK(player.get_last_statistics().reused_playouts == 0);
+}
+
+TEST_CASE("MctsPlayer beats a random player")
+{
+    auto mcts_player = std::make_shared<MctsPlayer>(
+        "mcts", MctsLimits{.max_playouts = 1'000}, 3, PlayerColor::dark);
+    auto random_player = std::make_shared<RandomPlayer>("random", 4);
+    auto game = DefaultGame<BitBoard>{
+        mcts_player, random_player, std::make_unique<NullNotifier>()};
+    auto num_wins = 0;
+    for (auto i = 0; i < 6; ++i) {
+        game.new_game(i > 0);
+        game.run_game_loop();
+        const auto score = game.get_result()->get_score();
+        const auto mcts_discs = score.get_num_fields_for(mcts_player->get_color());
+        const auto random_discs = score.get_num_fields_for(random_player->get_color());
+        num_wins += mcts_discs > random_discs ? 1 : 0;
+    }
+    CHECK(num_wins >= 5);
+}
+
+TEST_CASE("MctsSearch rejects invalid limits")
+{
+    CHECK_THROWS_AS(MctsSearch{MctsLimits{.num_threads = 0}}, std::invalid_argument);
+    CHECK_THROWS_AS(MctsSearch{MctsLimits{.max_nodes = 1}}, std::invalid_argument);
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "notifiers.hpp"
+
+#include <memory>
+#include <string>
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "default_game.hpp"
+#include "doctest.hpp"
+#include "random_player.hpp"
+#include "utilities.hpp"
+
+namespace reviser {
+
+using namespace std::string_literals;
+using ai::RandomPlayer;
+
+TEST_CASE("NullNotifier")
+{
+    auto game = DefaultGame<BitBoard>{
+        std::make_shared<RandomPlayer>("first", 1),
+        std::make_shared<RandomPlayer>("second", 2),
+        std::make_unique<NullNotifier>()};
+
+    game.new_game(false);
+    game.run_game_loop();
+
+    CHECK(game.get_result() != nullptr);
+}
+
+TEST_CASE("BufferedNotifier")
+{
+    auto spy = std::make_unique<SpyForNotifierOutput>();
+    auto* spy_ptr = spy.get();
+    auto expected_output = std::string{};
+    {
+        auto game = DefaultGame<BitBoard>{
+            std::make_shared<RandomPlayer>("first", 5),
+            std::make_shared<RandomPlayer>("second", 6),
+            std::move(spy)};
+        for (const auto swap_players : {false, true}) {
+            game.new_game(swap_players);
+            game.run_game_loop();
+        }
+        expected_output = spy_ptr->output();
+    }
+
+    auto buffered = std::make_unique<BufferedNotifier>();
+    auto* buffered_ptr = buffered.get();
+    auto game = DefaultGame<BitBoard>{
+        std::make_shared<RandomPlayer>("first", 5),
+        std::make_shared<RandomPlayer>("second", 6),
+        std::move(buffered)};
+    for (const auto swap_players : {false, true}) {
+        game.new_game(swap_players);
+        game.run_game_loop();
+    }
+    const auto& notifier = *buffered_ptr;
+
+    SUBCASE("records the games compactly")
+    {
+        REQUIRE(notifier.get_games().size() == 2);
+        const auto& first_game = notifier.get_games()[0];
+        CHECK(first_game.dark_player_name == "first");
+        CHECK(first_game.light_player_name == "second");
+        CHECK(first_game.moves.front().color == PlayerColor::dark);
+        CHECK(first_game.result.has_value());
+        CHECK(notifier.get_games()[1].dark_player_name == "second");
+    }
+
+    SUBCASE("renders the same text as a notifier that writes every message")
+    {
+        CHECK(notifier.to_string() == expected_output);
+    }
+
+    SUBCASE("replays moves and results into other notifiers")
+    {
+        auto replay_spy = NotifierSpy{};
+        notifier.replay(replay_spy);
+
+        CHECK(replay_spy.moves.size()
+              == notifier.get_games()[0].moves.size() + notifier.get_games()[1].moves.size());
+        CHECK(replay_spy.moves.front().player_name == "first");
+        CHECK(replay_spy.result_summary.type != "unknown");
+    }
+
+    SUBCASE("clear()")
+    {
+        buffered_ptr->clear();
+
+        CHECK(notifier.get_games().empty());
+        CHECK(notifier.to_string().empty());
+    }
+}
+
+TEST_CASE("BufferedNotifier keeps direct messages in order")
+{
+    auto notifier = BufferedNotifier{};
+    auto dark_player = std::make_shared<ConstantPlayerStub>("dark_player", PlayerColor::dark);
+    auto light_player
+        = std::make_shared<ConstantPlayerStub>("light_player", PlayerColor::light);
+    const auto players = Players{dark_player, light_player};
+    auto board = ArrayBoard{};
+    board.initialize();
+
+    notifier.display_message("Before the game.");
+    notifier.note_new_game(players, board);
+    notifier.display_message("After the new game.");
+    const auto pos = Position{Row{2}, Column{3}};
+    board.play_move(PlayerColor::dark, pos);
+    notifier.note_move(*dark_player, pos, board);
+    notifier.display_message("After the move.");
+
+    auto expected = SpyForNotifierOutput{};
+    auto expected_board = ArrayBoard{};
+    expected_board.initialize();
+    expected.display_message("Before the game.");
+    expected.note_new_game(players, expected_board);
+    expected.display_message("After the new game.");
+    expected_board.play_move(PlayerColor::dark, pos);
+    expected.note_move(*dark_player, pos, expected_board);
+    expected.display_message("After the move.");
+
+    CHECK(notifier.to_string() == expected.output());
+}
+
+} // namespace reviser
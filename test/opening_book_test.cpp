@@ -0,0 +1,186 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "opening_book.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "book_player.hpp"
+#include "doctest.hpp"
+#include "utilities.hpp"
+
+namespace reviser::ai {
+
+namespace {
+
+std::span<const std::uint8_t> as_bytes(const std::string& data)
+{
+    return {reinterpret_cast<const std::uint8_t*>(data.data()), data.size()};
+}
+
+BitBoard make_initial_board()
+{
+    auto board = BitBoard{};
+    board.initialize();
+    return board;
+}
+
+std::string write_book(const OpeningBookBuilder& builder)
+{
+    auto out = std::ostringstream{};
+    builder.write(out);
+    return out.str();
+}
+
+} // namespace
+
+TEST_CASE("compute_canonical_hash() is invariant under symmetries")
+{
+    auto board = make_initial_board();
+    board.play_move(PlayerColor::dark, Position{Row{4}, Column{2}});
+    const auto& played_board = board;
+    const auto dark_bits = played_board.get_bits_for(PlayerColor::dark);
+    const auto light_bits = played_board.get_bits_for(PlayerColor::light);
+    const auto expected = compute_canonical_hash(dark_bits, light_bits, PlayerColor::light);
+
+    for (const auto symmetry : all_symmetries) {
+        const auto canonical_hash = compute_canonical_hash(
+            transform_bits(dark_bits, symmetry),
+            transform_bits(light_bits, symmetry),
+            PlayerColor::light);
+        CHECK(canonical_hash.hash == expected.hash);
+    }
+    CHECK(
+        compute_canonical_hash(dark_bits, light_bits, PlayerColor::dark).hash != expected.hash);
+}
+
+TEST_CASE("OpeningBook")
+{
+    const auto first_move = Position{Row{4}, Column{2}};
+    const auto second_move = Position{Row{5}, Column{2}};
+    auto builder = OpeningBookBuilder{};
+    auto board = make_initial_board();
+    builder.add_move(board, PlayerColor::dark, first_move, 4);
+    board.play_move(PlayerColor::dark, first_move);
+    builder.add_move(board, PlayerColor::light, second_move, -4);
+    CHECK(builder.get_num_positions() == 2);
+
+    const auto data = write_book(builder);
+    CHECK(data.size() == opening_book_header_size + 2 * opening_book_entry_size);
+    const auto book = OpeningBook{as_bytes(data)};
+    REQUIRE(book.size() == 2);
+
+    SUBCASE("finds moves")
+    {
+        const auto book_move = book.find_move(make_initial_board(), PlayerColor::dark);
+        REQUIRE(book_move.has_value());
+        CHECK(book_move->move == first_move);
+        CHECK(book_move->score == 4);
+        CHECK(book_move->count == 1);
+
+        const auto reply = book.find_move(copy_board_as<ArrayBoard>(board), PlayerColor::light);
+        REQUIRE(reply.has_value());
+        CHECK(reply->move == second_move);
+        CHECK(reply->score == -4);
+    }
+
+    SUBCASE("maps moves of symmetric positions back")
+    {
+        // The initial position is symmetric under a rotation by 180 degrees.
+        auto rotated_board = make_initial_board();
+        const auto rotated_move = transform_position(first_move, Symmetry::rotate_180);
+        rotated_board.play_move(PlayerColor::dark, rotated_move);
+
+        const auto reply = book.find_move(rotated_board, PlayerColor::light);
+        REQUIRE(reply.has_value());
+        CHECK(reply->move == transform_position(second_move, Symmetry::rotate_180));
+    }
+
+    SUBCASE("misses")
+    {
+        CHECK_FALSE(book.find_move(board, PlayerColor::dark).has_value());
+        CHECK_FALSE(book.find_move(BitBoard{}, PlayerColor::dark).has_value());
+    }
+}
+
+TEST_CASE("OpeningBookBuilder selects moves")
+{
+    const auto board = make_initial_board();
+    const auto good_move = Position{Row{4}, Column{2}};
+    const auto popular_move = Position{Row{5}, Column{3}};
+    const auto rare_move = Position{Row{2}, Column{4}};
+
+    auto builder = OpeningBookBuilder{};
+    builder.add_move(board, PlayerColor::dark, popular_move, 2, 10);
+    builder.add_move(board, PlayerColor::dark, good_move, 6, 5);
+    builder.add_move(board, PlayerColor::dark, rare_move, 30, 1);
+
+    const auto data = write_book(builder);
+    const auto book_move = OpeningBook{as_bytes(data)}.find_move(board, PlayerColor::dark);
+    REQUIRE(book_move.has_value());
+    CHECK(book_move->move == good_move);
+    CHECK(book_move->count == 5);
+}
+
+TEST_CASE("OpeningBookBuilder adds games")
+{
+    auto record = GameRecord{};
+    record.score = Score{40, 20, 4};
+    record.moves = {20, 21, 22, 14, 34, 23, 7, 5, game_record_pass, 19};
+    auto builder = OpeningBookBuilder{};
+    builder.add_game(record, 4);
+    const auto data = write_book(builder);
+    const auto book = OpeningBook{as_bytes(data)};
+
+    CHECK(builder.get_num_positions() == 4);
+    const auto book_move = book.find_move(make_initial_board(), PlayerColor::dark);
+    REQUIRE(book_move.has_value());
+    CHECK(book_move->move == Position::from_linear_index(20));
+    CHECK(book_move->score == 20);
+}
+
+TEST_CASE("OpeningBook rejects invalid data")
+{
+    auto data = write_book(OpeningBookBuilder{});
+    CHECK(OpeningBook{as_bytes(data)}.size() == 0);
+    data[0] = 'X';
+    CHECK_THROWS_AS(OpeningBook{as_bytes(data)}, std::invalid_argument);
+    CHECK_THROWS_AS(
+        OpeningBook{std::filesystem::path{"no-such-opening-book.bin"}}, std::invalid_argument);
+}
+
+TEST_CASE("BookPlayer")
+{
+    const auto book_move = Position{Row{4}, Column{2}};
+    auto builder = OpeningBookBuilder{};
+    builder.add_move(make_initial_board(), PlayerColor::dark, book_move, 0);
+    const auto path = std::filesystem::temp_directory_path() / "reviser_book_player_test.bin";
+    builder.write(path);
+
+    {
+        const auto wrapped_player = std::make_shared<MinimalPlayer>();
+        auto player = BookPlayer{wrapped_player, std::make_shared<const OpeningBook>(path)};
+        player.set_color(PlayerColor::dark);
+        auto board = ArrayBoard{};
+        board.initialize();
+
+        CHECK(player.pick_move(board) == book_move);
+        CHECK(player.get_num_book_moves() == 1);
+
+        board.play_move(PlayerColor::dark, book_move);
+        player.set_color(PlayerColor::light);
+        CHECK(player.pick_move(board) == min(board.find_valid_moves(PlayerColor::light)));
+        CHECK(wrapped_player->get_color() == PlayerColor::light);
+        CHECK(player.get_num_book_moves() == 1);
+
+        player.new_game();
+        CHECK(player.get_num_book_moves() == 0);
+    }
+    std::filesystem::remove(path);
+}
+
+} // namespace reviser::ai
@@ -0,0 +1,152 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "pattern_evaluator.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "bit_board.hpp"
+#include "doctest.hpp"
+#include "evaluation.hpp"
+#include "search_player.hpp"
+
+using namespace reviser;
+using namespace reviser::ai;
+
+namespace {
+
+PatternIndices recompute_indices(const BitBoard& board)
+{
+    return compute_pattern_indices(
+        board.get_bits_for(PlayerColor::dark), board.get_bits_for(PlayerColor::light));
+}
+
+int evaluate_field_values(const BitBoard& board, const PlayerColor pc)
+{
+    const auto player_field = field_for_player_color(pc);
+    auto result = 0;
+    for (const auto pos : all_board_positions()) {
+        if (const Field field = board[pos]; field == player_field) {
+            result += field_value(pos);
+        }
+        else if (field != Field::empty) {
+            result -= field_value(pos);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("The patterns cover every field")
+{
+    CHECK(num_pattern_instances == 46);
+    for (const auto& patterns : field_patterns) {
+        CHECK(patterns.size > 0);
+    }
+    const auto& last_instance = pattern_instances.back();
+    CHECK(
+        last_instance.weight_offset
+            + pattern_types[last_instance.type].get_num_configurations()
+        == num_weights_per_phase);
+}
+
+TEST_CASE("PatternEvaluator updates the indices incrementally")
+{
+    auto rng = std::mt19937{4711};
+    auto board = BitBoard{};
+    board.initialize();
+    auto evaluator = PatternEvaluator{};
+    evaluator.set_board(board);
+    const auto initial_indices = evaluator.get_indices().indices;
+    CHECK(initial_indices == recompute_indices(board).indices);
+
+    auto records = std::vector<FlipRecord>{};
+    auto pc = PlayerColor::dark;
+    for (auto num_passes = 0; num_passes < 2; pc = other_player_color(pc)) {
+        const auto moves = board.find_valid_moves(pc);
+        if (moves.empty()) {
+            ++num_passes;
+            continue;
+        }
+        num_passes = 0;
+        auto moves_vector = std::vector(moves.begin(), moves.end());
+        const auto move = moves_vector[rng() % moves_vector.size()];
+        const auto record = board.play_move(pc, move);
+        evaluator.play_move(record);
+        records.push_back(record);
+        REQUIRE(evaluator.get_indices().indices == recompute_indices(board).indices);
+    }
+
+    for (auto it = records.rbegin(); it != records.rend(); ++it) {
+        evaluator.undo_move(*it);
+        board.undo_move(*it);
+    }
+    CHECK(evaluator.get_indices().indices == initial_indices);
+}
+
+TEST_CASE("The default pattern weights approximate the field values")
+{
+    auto rng = std::mt19937{1234};
+    auto board = BitBoard{};
+    board.initialize();
+    auto pc = PlayerColor::dark;
+    for (auto i = 0; i < 40; ++i, pc = other_player_color(pc)) {
+        const auto moves = board.find_valid_moves(pc);
+        if (moves.empty()) {
+            continue;
+        }
+        auto moves_vector = std::vector(moves.begin(), moves.end());
+        board.play_move(pc, moves_vector[rng() % moves_vector.size()]);
+
+        auto evaluator = PatternEvaluator{};
+        evaluator.set_board(board);
+        const auto score = evaluator.evaluate(board, pc);
+        CHECK(score == -evaluator.evaluate(board, other_player_color(pc)));
+        CHECK(std::abs(score - evaluate_field_values(board, pc)) <= 23);
+
+        for (const auto symmetry : all_symmetries) {
+            const auto transformed_board = board.transform(symmetry);
+            auto transformed_evaluator = PatternEvaluator{};
+            transformed_evaluator.set_board(transformed_board);
+            CHECK(transformed_evaluator.evaluate(transformed_board, pc) == score);
+        }
+    }
+}
+
+TEST_CASE("PatternWeights can be saved and loaded")
+{
+    auto weights = PatternWeights{3};
+    CHECK(weights.get_phase(4) == 0);
+    CHECK(weights.get_phase(64) == 2);
+    weights.get_weights(1)[17] = 42;
+    weights.get_weights(2)[num_weights_per_phase - 1] = -7;
+
+    const auto path = std::filesystem::temp_directory_path() / "reviser_pattern_weights_test.bin";
+    weights.save(path);
+    const auto loaded_weights = PatternWeights::load(path);
+    CHECK(loaded_weights.get_num_phases() == 3);
+    CHECK(loaded_weights.get_weights(1)[17] == 42);
+    CHECK(loaded_weights.get_weights(2)[num_weights_per_phase - 1] == -7);
+    CHECK(loaded_weights.get_weights(0)[17] == 0);
+
+    {
+        auto out = std::ofstream{path, std::ios::binary};
+        out << "RVGR";
+    }
+    CHECK_THROWS_AS(PatternWeights::load(path), std::invalid_argument);
+    std::filesystem::remove(path);
+    CHECK_THROWS_AS(PatternWeights{0}, std::invalid_argument);
+}
+
+TEST_CASE("SearchPlayer with a PatternEvaluator picks valid moves")
+{
+    auto board = BitBoard{};
+    board.initialize();
+    const auto player = SearchPlayer<BitBoard, PatternEvaluator>{
+        "pattern", SearchLimits{.max_depth = 3}, PlayerColor::dark};
+    CHECK(board.find_valid_moves(PlayerColor::dark).contains(player.pick_move(board)));
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "pattern_training.hpp"
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "bit_board.hpp"
+#include "default_game.hpp"
+#include "doctest.hpp"
+#include "random_player.hpp"
+
+using namespace reviser;
+using namespace reviser::ai;
+
+namespace {
+
+std::vector<GameRecord> make_random_game_records(const int num_games)
+{
+    auto stream = std::stringstream{};
+    auto game = DefaultGame<BitBoard>{
+        std::make_shared<RandomPlayer>("first", 21),
+        std::make_shared<RandomPlayer>("second", 22),
+        std::make_unique<GameRecordWriter>(stream)};
+    for (auto i = 0; i < num_games; ++i) {
+        game.new_game(i > 0);
+        game.run_game_loop();
+    }
+
+    auto result = std::vector<GameRecord>{};
+    auto reader = GameRecordReader{stream};
+    for (auto record = GameRecord{}; reader.read_next(record);) {
+        result.push_back(record);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("TrainingSet extracts the positions of a game record")
+{
+    // Dark has to pass after the first eight moves; light wins 12 to 0.
+    const auto record = GameRecord{
+        GameResultType::win_by_score,
+        0,
+        Score{0, 12, 52},
+        "dark",
+        "light",
+        {20, 21, 22, 14, 34, 23, 7, 5, game_record_pass, 19}};
+    auto training_set = TrainingSet{};
+    CHECK(training_set.add_game(record) == 9);
+    REQUIRE(training_set.size() == 9);
+
+    auto board = BitBoard{};
+    board.initialize();
+    auto pc = PlayerColor::dark;
+    auto position_index = std::size_t{0};
+    for (const auto move : record.moves) {
+        if (move != game_record_pass) {
+            const auto& position = training_set.get_positions()[position_index++];
+            const auto& const_board = board;
+            const auto expected = compute_pattern_indices(
+                const_board.get_bits_for(PlayerColor::dark),
+                const_board.get_bits_for(PlayerColor::light));
+            CHECK(position.indices == expected.for_player(pc));
+            CHECK(position.num_discs == board.compute_score().get_num_dark_fields()
+                                            + board.compute_score().get_num_light_fields());
+            CHECK(position.disc_difference == (pc == PlayerColor::dark ? -12 : 12));
+            board.play_move(pc, Position::from_linear_index(move));
+        }
+        pc = other_player_color(pc);
+    }
+}
+
+TEST_CASE("TrainingSet rejects invalid games")
+{
+    auto training_set = TrainingSet{};
+    auto record = GameRecord{GameResultType::win_by_score, 0, Score{0, 0, 0}, "", "", {20, 20}};
+    CHECK_THROWS_AS(training_set.add_game(record), std::invalid_argument);
+    CHECK(training_set.size() == 0);
+
+    record.result_type = GameResultType::win_by_opponent_mistake;
+    CHECK(training_set.add_game(record) == 0);
+}
+
+TEST_CASE("train_pattern_weights() reduces the prediction error")
+{
+    auto training_set = TrainingSet{};
+    for (const auto& record : make_random_game_records(200)) {
+        training_set.add_game(record);
+    }
+
+    auto errors = std::vector<double>{};
+    const auto weights = train_pattern_weights(
+        training_set,
+        TrainingConfig{.num_phases = 4, .num_epochs = 20, .num_threads = 3},
+        [&errors](const std::size_t epoch, const double mean_squared_error) {
+            CHECK(epoch == errors.size() + 1);
+            errors.push_back(mean_squared_error);
+        });
+    REQUIRE(errors.size() == 20);
+    CHECK(errors.back() < errors.front() / 4);
+    CHECK(weights.get_num_phases() == 4);
+
+    // The weights predict the labels of the training positions better than zero.
+    auto squared_error = 0.0;
+    auto squared_label = 0.0;
+    for (const auto& position : training_set.get_positions()) {
+        auto indices = PatternIndices{};
+        indices.indices[0] = position.indices;
+        const auto prediction
+            = static_cast<double>(weights.evaluate(indices, PlayerColor::dark, position.num_discs))
+              / pattern_score_scale;
+        squared_error += (prediction - position.disc_difference)
+                         * (prediction - position.disc_difference);
+        squared_label += position.disc_difference * position.disc_difference;
+    }
+    CHECK(squared_error < squared_label / 4);
+}
+
+TEST_CASE("train_pattern_weights() needs positions")
+{
+    CHECK_THROWS_AS(
+        static_cast<void>(train_pattern_weights(TrainingSet{}, TrainingConfig{})),
+        std::invalid_argument);
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "perft.hpp"
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "doctest.hpp"
+
+using reviser::ArrayBoard;
+using reviser::BitBoard;
+using reviser::Column;
+using reviser::find_perft_reference_count;
+using reviser::perft;
+using reviser::PlayerColor;
+using reviser::Position;
+using reviser::Row;
+
+TEST_CASE_TEMPLATE("perft() matches the reference counts.", BoardT, ArrayBoard, BitBoard)
+{
+    auto board = BoardT{};
+    board.initialize();
+    const auto initial_board = board;
+
+    for (auto depth = 0; depth <= 6; ++depth) {
+        CHECK(perft(board, PlayerColor::dark, depth) == find_perft_reference_count(depth));
+    }
+    CHECK(board == initial_board);
+}
+
+TEST_CASE("perft() counts passes as plies and finished games as leaves.")
+{
+    auto board = BitBoard::from_string("|*|*|*|*|*|*|*|*|\n"
+                                       "|*|*|*|*|*|*|*|*|\n"
+                                       "|*|*|*|*|*|*|*|*|\n"
+                                       "|*|*|*|*|*|*|*|*|\n"
+                                       "|*|*|*|*|*|*|*|*|\n"
+                                       "|*|*|*|*|*|*|*|*|\n"
+                                       "|*|*|*|*|*|*|*|*|\n"
+                                       "|*|*|*|*|*|*|O| |");
+
+    CHECK(perft(board, PlayerColor::light, 1) == 1);
+    CHECK(perft(board, PlayerColor::dark, 1) == 1);
+    CHECK(perft(board, PlayerColor::dark, 5) == 1);
+
+    board.play_move(PlayerColor::dark, Position{Row{7}, Column{7}});
+    CHECK(board.find_valid_moves(PlayerColor::light).empty());
+    CHECK(perft(board, PlayerColor::light, 5) == 1);
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "position_set.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <vector>
+
+#include "doctest.hpp"
+
+using reviser::Column;
+using reviser::Position;
+using reviser::PositionSet;
+using reviser::Row;
+
+static_assert(std::ranges::forward_range<PositionSet>);
+static_assert(std::ranges::sized_range<PositionSet>);
+static_assert(sizeof(PositionSet) == sizeof(std::uint64_t));
+
+TEST_CASE("PositionSet: default constructed sets are empty.")
+{
+    constexpr auto positions = PositionSet{};
+
+    CHECK(positions.empty());
+    CHECK(positions.size() == 0);
+    CHECK(positions.begin() == positions.end());
+}
+
+TEST_CASE("PositionSet: insert(), erase(), contains()")
+{
+    auto positions = PositionSet{};
+    const auto pos = Position{Row{3}, Column{5}};
+
+    positions.insert(pos);
+    CHECK(positions.contains(pos));
+    CHECK_FALSE(positions.contains(Position{Row{5}, Column{3}}));
+    CHECK(positions.size() == 1);
+
+    positions.insert(pos);
+    CHECK(positions.size() == 1);
+
+    positions.erase(pos);
+    CHECK_FALSE(positions.contains(pos));
+    CHECK(positions.empty());
+}
+
+TEST_CASE("PositionSet: iteration is in ascending order.")
+{
+    const auto positions = PositionSet{
+        Position{Row{7}, Column{7}},
+        Position{Row{0}, Column{3}},
+        Position{Row{4}, Column{1}},
+        Position{Row{0}, Column{0}}};
+    const auto expected = std::vector<Position>{
+        Position{Row{0}, Column{0}},
+        Position{Row{0}, Column{3}},
+        Position{Row{4}, Column{1}},
+        Position{Row{7}, Column{7}}};
+
+    CHECK(positions.size() == 4);
+    CHECK(std::ranges::equal(positions, expected));
+    CHECK(std::ranges::min(positions) == Position{Row{0}, Column{0}});
+}
+
+TEST_CASE("PositionSet: get_bits() and construction from bits")
+{
+    const auto positions
+        = PositionSet{Position{Row{0}, Column{1}}, Position{Row{1}, Column{0}}};
+
+    CHECK(positions.get_bits() == 0b1'0000'0010ULL);
+    CHECK(PositionSet{positions.get_bits()} == positions);
+}
+
+TEST_CASE("PositionSet: operator|=")
+{
+    auto positions = PositionSet{Position{Row{0}, Column{1}}};
+    positions |= PositionSet{Position{Row{2}, Column{2}}};
+
+    CHECK(
+        positions
+        == PositionSet{Position{Row{0}, Column{1}}, Position{Row{2}, Column{2}}});
+}
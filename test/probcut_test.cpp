@@ -0,0 +1,168 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "probcut.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "bit_board.hpp"
+#include "doctest.hpp"
+#include "evaluation.hpp"
+#include "pattern_evaluator.hpp"
+#include "search.hpp"
+
+using namespace reviser;
+using namespace reviser::ai;
+
+namespace {
+BitBoard random_position(std::mt19937& rng, int num_moves)
+{
+    auto board = BitBoard{};
+    board.initialize();
+    auto pc = PlayerColor::dark;
+    for (auto i = 0; i < num_moves; ++i) {
+        const auto moves = board.find_valid_moves(pc);
+        if (!moves.empty()) {
+            auto it = moves.begin();
+            std::advance(it, rng() % moves.size());
+            board.play_move(pc, *it);
+        }
+        pc = other_player_color(pc);
+    }
+    return board;
+}
+} // namespace
+
+TEST_CASE("ProbCutParameters predict deep searches by shallower ones of the same parity.")
+{
+    for (auto depth = ProbCutParameters::min_depth; depth <= 20; ++depth) {
+        const auto shallow_depth = ProbCutParameters::get_shallow_depth(depth);
+        CHECK(shallow_depth >= 1);
+        CHECK(shallow_depth < depth);
+        CHECK((depth - shallow_depth) % 2 == 0);
+    }
+}
+
+TEST_CASE("ProbCutParameters store regressions by stage and depth.")
+{
+    auto parameters = ProbCutParameters{3, 6};
+    CHECK(parameters.get_stage(4) == 0);
+    CHECK(parameters.get_stage(64) == 2);
+    CHECK_FALSE(parameters.get_regression(1, 4).is_valid());
+
+    parameters.set_regression(1, 4, {1.1, -2.0, 12.5});
+
+    CHECK(parameters.get_regression(1, 4).is_valid());
+    CHECK(parameters.get_regression(1, 4).sigma == 12.5);
+    CHECK_FALSE(parameters.get_regression(2, 4).is_valid());
+    CHECK_THROWS_AS(parameters.get_regression(3, 4), std::invalid_argument);
+    CHECK_THROWS_AS(parameters.get_regression(0, 7), std::invalid_argument);
+    CHECK_THROWS_AS(parameters.set_cut_threshold(-1.0), std::invalid_argument);
+    CHECK_THROWS_AS(ProbCutParameters(0, 6), std::invalid_argument);
+    CHECK_THROWS_AS(ProbCutParameters(1, 2), std::invalid_argument);
+}
+
+TEST_CASE("ProbCutParameters can be saved and loaded.")
+{
+    auto parameters = ProbCutParameters{2, 5};
+    parameters.set_regression(0, 3, {0.5, 1.25, 7.0});
+    parameters.set_regression(1, 5, {1.5, -3.0, 20.0});
+
+    const auto path = std::filesystem::temp_directory_path() / "reviser_probcut_test.txt";
+    parameters.save(path);
+    const auto loaded_parameters = ProbCutParameters::load(path);
+    CHECK(loaded_parameters.get_num_stages() == 2);
+    CHECK(loaded_parameters.get_max_depth() == 5);
+    CHECK(loaded_parameters.get_regression(0, 3).slope == 0.5);
+    CHECK(loaded_parameters.get_regression(0, 3).intercept == 1.25);
+    CHECK(loaded_parameters.get_regression(1, 5).sigma == 20.0);
+    CHECK_FALSE(loaded_parameters.get_regression(1, 4).is_valid());
+
+    {
+        auto out = std::ofstream{path};
+        out << "RVPW";
+    }
+    CHECK_THROWS_AS(ProbCutParameters::load(path), std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("fit_probcut_parameters() recovers a linear relation.")
+{
+    // Deep values are 2 * shallow values + 3, off by one in alternating directions.
+    auto samples = std::vector<ProbCutSample>{};
+    for (auto i = 0; i < 100; ++i) {
+        auto& sample = samples.emplace_back(ProbCutSample{20, std::vector<int>(4)});
+        sample.values[1] = i;
+        sample.values[3] = 2 * i + 3 + (i % 2 == 0 ? 1 : -1);
+    }
+    // Finished games are ignored.
+    samples.push_back({20, {0, win_score + 10, 0, -win_score}});
+    // Too few samples for the other stage.
+    samples.push_back({60, {0, 1, 0, 5}});
+
+    const auto parameters = fit_probcut_parameters(samples, 2, 3);
+
+    const auto& regression = parameters.get_regression(0, 3);
+    REQUIRE(regression.is_valid());
+    CHECK(regression.slope == doctest::Approx(2.0).epsilon(0.01));
+    CHECK(regression.intercept == doctest::Approx(3.0).epsilon(0.05));
+    CHECK(regression.sigma == doctest::Approx(1.0).epsilon(0.05));
+    CHECK_FALSE(parameters.get_regression(1, 3).is_valid());
+}
+
+TEST_CASE("ProbCutParameters::get_default() has regressions for all stages.")
+{
+    const auto parameters = ProbCutParameters::get_default();
+    for (std::size_t stage = 0; stage < parameters->get_num_stages(); ++stage) {
+        for (auto depth = ProbCutParameters::min_depth; depth <= parameters->get_max_depth();
+             ++depth) {
+            CHECK(parameters->get_regression(stage, depth).is_valid());
+        }
+    }
+}
+
+TEST_CASE("AlphaBetaSearch with ProbCut searches fewer nodes.")
+{
+    auto rng = std::mt19937{24};
+    const auto limits = SearchLimits{.max_depth = 6};
+    auto full_search = AlphaBetaSearch<BitBoard, PatternEvaluator>{limits};
+    auto safe_search = AlphaBetaSearch<BitBoard, PatternEvaluator>{limits};
+    auto selective_search = AlphaBetaSearch<BitBoard, PatternEvaluator>{limits};
+    auto safe_parameters = std::make_shared<ProbCutParameters>(*ProbCutParameters::get_default());
+    safe_parameters->set_cut_threshold(1e12);
+    safe_search.set_probcut_parameters(safe_parameters);
+    auto aggressive_parameters
+        = std::make_shared<ProbCutParameters>(*ProbCutParameters::get_default());
+    aggressive_parameters->set_cut_threshold(0.0);
+    selective_search.set_probcut_parameters(aggressive_parameters);
+    CHECK(selective_search.get_probcut_parameters() == aggressive_parameters);
+
+    auto full_nodes = std::uint64_t{};
+    auto selective_nodes = std::uint64_t{};
+    for (auto i = 0; i < 4; ++i) {
+        const auto board = random_position(rng, 16 + 4 * i);
+        const auto pc = PlayerColor::dark;
+        if (board.find_valid_moves(pc).empty()) {
+            continue;
+        }
+
+        const auto full_result = full_search.search(board, pc);
+        const auto safe_result = safe_search.search(board, pc);
+        const auto selective_result = selective_search.search(board, pc);
+
+        // Bounds beyond the range of scores never start a shallow search.
+        CHECK(safe_result.score == full_result.score);
+        CHECK(safe_result.best_move == full_result.best_move);
+        CHECK(safe_result.statistics.nodes == full_result.statistics.nodes);
+        CHECK(selective_result.statistics.completed_depth == 6);
+        REQUIRE(selective_result.best_move.has_value());
+        CHECK(board.is_valid_move(pc, *selective_result.best_move));
+        full_nodes += full_result.statistics.nodes;
+        selective_nodes += selective_result.statistics.nodes;
+    }
+    CHECK(selective_nodes < full_nodes);
+}
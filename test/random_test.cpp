@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "random.hpp"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bit_board.hpp"
+#include "doctest.hpp"
+#include "random_player.hpp"
+
+using reviser::BitBoard;
+using reviser::other_player_color;
+using reviser::PlayerColor;
+using reviser::Position;
+using reviser::Xoshiro256;
+using reviser::ai::RandomPlayer;
+
+static_assert(std::uniform_random_bit_generator<Xoshiro256>);
+
+TEST_CASE("Xoshiro256 is deterministic for a given seed.")
+{
+    auto rng1 = Xoshiro256{17};
+    auto rng2 = Xoshiro256{17};
+    auto rng3 = Xoshiro256{18};
+
+    for (auto i = 0; i < 100; ++i) {
+        const auto value = rng1();
+        CHECK(value == rng2());
+        CHECK(value != rng3());
+    }
+}
+
+TEST_CASE("Xoshiro256::uniform_index() covers the whole range.")
+{
+    auto rng = Xoshiro256{1};
+    auto counts = std::array<int, 7>{};
+    for (auto i = 0; i < 7000; ++i) {
+        const auto index = rng.uniform_index(counts.size());
+        REQUIRE(index < counts.size());
+        ++counts[index];
+    }
+    for (const auto count : counts) {
+        CHECK(count > 800);
+        CHECK(count < 1200);
+    }
+}
+
+TEST_CASE("RandomPlayer with a seed plays reproducible games.")
+{
+    const auto play_game = [](const std::uint64_t seed) {
+        const auto dark_player = RandomPlayer{"dark", seed, PlayerColor::dark};
+        const auto light_player = RandomPlayer{"light", seed + 1, PlayerColor::light};
+        auto board = BitBoard{};
+        board.initialize();
+        auto moves = std::vector<Position>{};
+        auto pc = PlayerColor::dark;
+        for (auto num_passes = 0; num_passes < 2; pc = other_player_color(pc)) {
+            if (board.find_valid_moves(pc).empty()) {
+                ++num_passes;
+                continue;
+            }
+            num_passes = 0;
+            const auto& player = pc == PlayerColor::dark ? dark_player : light_player;
+            const auto move = player.pick_move(board);
+            REQUIRE(board.is_valid_move(pc, move));
+            board.play_move(pc, move);
+            moves.push_back(move);
+        }
+        return moves;
+    };
+
+    CHECK(play_game(42) == play_game(42));
+    CHECK(play_game(42) != play_game(43));
+}
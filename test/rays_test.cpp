@@ -0,0 +1,57 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "rays.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "doctest.hpp"
+
+using reviser::Column;
+using reviser::Position;
+using reviser::Row;
+using reviser::rays_from;
+
+namespace {
+std::vector<std::size_t> ray_indices(const Position pos, const std::size_t direction)
+{
+    const auto& ray = rays_from(pos.to_linear_index())[direction];
+    return {ray.begin(), ray.end()};
+}
+} // namespace
+
+static_assert(rays_from(0)[0].empty());
+static_assert(rays_from(0)[2].length == 7);
+static_assert(rays_from(63)[4].empty());
+
+TEST_CASE("rays_from() lists the fields in each direction ordered by distance.")
+{
+    const auto pos = Position{Row{2}, Column{5}};
+
+    // N, NE, E, SE, S, SW, W, NW
+    CHECK(ray_indices(pos, 0) == std::vector<std::size_t>{13, 5});
+    CHECK(ray_indices(pos, 1) == std::vector<std::size_t>{14, 7});
+    CHECK(ray_indices(pos, 2) == std::vector<std::size_t>{22, 23});
+    CHECK(ray_indices(pos, 3) == std::vector<std::size_t>{30, 39});
+    CHECK(ray_indices(pos, 4) == std::vector<std::size_t>{29, 37, 45, 53, 61});
+    CHECK(ray_indices(pos, 5) == std::vector<std::size_t>{28, 35, 42, 49, 56});
+    CHECK(ray_indices(pos, 6) == std::vector<std::size_t>{20, 19, 18, 17, 16});
+    CHECK(ray_indices(pos, 7) == std::vector<std::size_t>{12, 3});
+}
+
+TEST_CASE("Every field has rays covering all other fields on its lines.")
+{
+    for (auto index = 0u; index < 64; ++index) {
+        auto total_length = 0;
+        for (const auto& ray : rays_from(index)) {
+            total_length += ray.length;
+            CHECK(std::ranges::none_of(ray, [&](auto i) { return i == index; }));
+        }
+        const auto pos = Position::from_linear_index(index);
+        const int row = pos.get_row();
+        const int col = pos.get_column();
+        const auto num_diagonal = std::min(row, col) + std::min(7 - row, 7 - col)
+                                  + std::min(row, 7 - col) + std::min(7 - row, col);
+        CHECK(total_length == 14 + num_diagonal);
+    }
+}
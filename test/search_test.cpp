@@ -0,0 +1,161 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "default_game.hpp"
+#include "doctest.hpp"
+#include "random_player.hpp"
+#include "search_player.hpp"
+#include "utilities.hpp"
+
+using namespace reviser;
+using namespace reviser::ai;
+
+namespace {
+template <BoardType BoardT>
+int minimax(BoardT& board, PlayerColor pc, int depth, bool opponent_passed = false)
+{
+    const auto moves = board.find_valid_moves(pc);
+    if (moves.empty()) {
+        if (opponent_passed) {
+            return terminal_score(board.compute_score(), pc);
+        }
+        return -minimax(board, other_player_color(pc), depth, true);
+    }
+    if (depth == 0) {
+        return evaluate_position(board, pc);
+    }
+    auto result = -win_score * 2;
+    for (const auto move : moves) {
+        const auto record = board.play_move(pc, move);
+        result = std::max(result, -minimax(board, other_player_color(pc), depth - 1));
+        board.undo_move(record);
+    }
+    return result;
+}
+
+BitBoard random_position(std::mt19937& rng, int num_moves)
+{
+    auto board = BitBoard{};
+    board.initialize();
+    auto pc = PlayerColor::dark;
+    for (auto i = 0; i < num_moves; ++i) {
+        const auto moves = board.find_valid_moves(pc);
+        if (!moves.empty()) {
+            auto it = moves.begin();
+            std::advance(it, rng() % moves.size());
+            board.play_move(pc, *it);
+        }
+        pc = other_player_color(pc);
+    }
+    return board;
+}
+} // namespace
+
+TEST_CASE("AlphaBetaSearch computes the minimax value.")
+{
+    auto rng = std::mt19937{1234};
+    for (auto i = 0; i < 10; ++i) {
+        auto board = random_position(rng, 10 + 4 * i);
+        for (const auto pc : {PlayerColor::dark, PlayerColor::light}) {
+            if (board.find_valid_moves(pc).empty()) {
+                continue;
+            }
+            auto search = AlphaBetaSearch<BitBoard>{SearchLimits{.max_depth = 3}};
+            const auto result = search.search(board, pc);
+            REQUIRE(result.best_move.has_value());
+            CHECK(board.is_valid_move(pc, *result.best_move));
+            CHECK(result.statistics.completed_depth == 3);
+            CHECK(result.score == minimax(board, pc, 3));
+        }
+    }
+}
+
+TEST_CASE("AlphaBetaSearch thread settings do not change the minimax value.")
+{
+    auto rng = std::mt19937{4321};
+    for (auto i = 0; i < 5; ++i) {
+        auto board = random_position(rng, 12 + 6 * i);
+        if (board.find_valid_moves(PlayerColor::dark).empty()) {
+            continue;
+        }
+        for (std::size_t rotation = 0; rotation < 4; ++rotation) {
+            auto search = AlphaBetaSearch<BitBoard>{SearchLimits{.max_depth = 2}};
+            search.set_thread_settings({.depth_offset = 1, .root_move_rotation = rotation});
+            const auto result = search.search(board, PlayerColor::dark);
+            CHECK(result.statistics.completed_depth == 3);
+            CHECK(result.score == minimax(board, PlayerColor::dark, 3));
+        }
+    }
+}
+
+TEST_CASE("AlphaBetaSearch stops when the stop flag is set.")
+{
+    auto board = BitBoard{};
+    board.initialize();
+    const auto stop_flag = std::atomic<bool>{true};
+    auto search = AlphaBetaSearch<BitBoard>{SearchLimits{.max_depth = 20}};
+    search.set_thread_settings({.stop_flag = &stop_flag});
+    const auto result = search.search(board, PlayerColor::dark);
+
+    REQUIRE(result.best_move.has_value());
+    CHECK(result.statistics.completed_depth == 0);
+    CHECK(result.statistics.nodes < 100);
+}
+
+TEST_CASE("AlphaBetaSearch finds a winning move at the end of the game.")
+{
+    const auto board = ArrayBoard::from_string("|*|*|*|*|*|*|*|*|\n"
+                                               "|*|*|*|*|*|*|*|*|\n"
+                                               "|*|*|*|*|*|*|*|*|\n"
+                                               "|*|*|*|*|*|*|*|*|\n"
+                                               "|*|*|*|*|*|*|*|*|\n"
+                                               "|*|*|*|*|*|*|*|*|\n"
+                                               "|*|*|*|*|*|*|*|*|\n"
+                                               "|*|O|O|O|O|O|O| |");
+    auto search = AlphaBetaSearch<ArrayBoard>{};
+    const auto result = search.search(board, PlayerColor::dark);
+
+    REQUIRE(result.best_move.has_value());
+    CHECK(*result.best_move == Position{Row{7}, Column{7}});
+    CHECK(result.score == terminal_score(Score{64, 0, 0}, PlayerColor::dark));
+}
+
+TEST_CASE("AlphaBetaSearch respects the node limit.")
+{
+    auto board = BitBoard{};
+    board.initialize();
+    auto search = AlphaBetaSearch<BitBoard>{SearchLimits{.max_depth = 20, .max_nodes = 5000}};
+    const auto result = search.search(board, PlayerColor::dark);
+
+    REQUIRE(result.best_move.has_value());
+    CHECK(board.is_valid_move(PlayerColor::dark, *result.best_move));
+    CHECK(result.statistics.nodes <= 5001);
+    CHECK(result.statistics.completed_depth < 20);
+}
+
+TEST_CASE("SearchPlayer plays complete games.")
+{
+    auto search_player
+        = std::make_shared<SearchPlayer<BitBoard>>("search", SearchLimits{.max_depth = 3});
+    auto random_player = std::make_shared<RandomPlayer>("random");
+    auto notifier_spy = std::make_unique<NotifierSpy>();
+    const auto* notifier_spy_ptr = notifier_spy.get();
+    auto game = DefaultGame<ArrayBoard>{search_player, random_player, std::move(notifier_spy)};
+
+    game.new_game(false);
+    game.run_game_loop();
+
+    CHECK(notifier_spy_ptr->result_summary.type != "wrong_move");
+    CHECK(search_player->get_last_statistics().nodes > 0);
+    CHECK(
+        search_player->get_total_statistics().nodes
+        >= search_player->get_last_statistics().nodes);
+    CHECK(search_player->get_last_statistics().get_nodes_per_second() > 0.0);
+}
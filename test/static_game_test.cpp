@@ -0,0 +1,86 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "static_game.hpp"
+
+#include <memory>
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "default_game.hpp"
+#include "doctest.hpp"
+#include "random_player.hpp"
+#include "search_player.hpp"
+#include "utilities.hpp"
+
+using namespace reviser;
+using reviser::ai::RandomPlayer;
+using reviser::ai::SearchLimits;
+using reviser::ai::SearchPlayer;
+
+static_assert(StaticPlayerFor<RandomPlayer, ArrayBoard>);
+static_assert(StaticPlayerFor<SearchPlayer<BitBoard>, BitBoard>);
+static_assert(StaticPlayerFor<MinimalPlayer, ArrayBoard>);
+
+TEST_CASE("StaticGame plays the same games as DefaultGame.")
+{
+    for (const auto swap_players : {false, true}) {
+        auto default_spy = std::make_unique<NotifierSpy>();
+        const auto* default_spy_ptr = default_spy.get();
+        auto default_game = DefaultGame<ArrayBoard>{
+            std::make_shared<RandomPlayer>("first", 1),
+            std::make_shared<RandomPlayer>("second", 2),
+            std::move(default_spy)};
+
+        auto static_spy = std::make_unique<NotifierSpy>();
+        const auto* static_spy_ptr = static_spy.get();
+        auto static_game = StaticGame<ArrayBoard, RandomPlayer, RandomPlayer, NotifierSpy>{
+            std::make_shared<RandomPlayer>("first", 1),
+            std::make_shared<RandomPlayer>("second", 2),
+            std::move(static_spy)};
+
+        default_game.new_game(swap_players);
+        default_game.run_game_loop();
+        static_game.new_game(swap_players);
+        static_game.run_game_loop();
+
+        CHECK(static_spy_ptr->moves == default_spy_ptr->moves);
+        CHECK(static_spy_ptr->result_summary.type == default_spy_ptr->result_summary.type);
+        CHECK(static_spy_ptr->result_summary.winner == default_spy_ptr->result_summary.winner);
+        CHECK(
+            static_game.get_result()->get_score().get_num_dark_fields()
+            == default_game.get_result()->get_score().get_num_dark_fields());
+    }
+}
+
+TEST_CASE("StaticGame disqualifies players that make invalid moves.")
+{
+    auto notifier_spy = std::make_unique<NotifierSpy>();
+    const auto* notifier_spy_ptr = notifier_spy.get();
+    auto game = StaticGame<ArrayBoard, ConstantPlayerStub, MinimalPlayer, NotifierSpy>{
+        std::make_shared<ConstantPlayerStub>(),
+        std::make_shared<MinimalPlayer>(),
+        std::move(notifier_spy)};
+
+    game.new_game(false);
+    game.run_game_loop();
+
+    CHECK(notifier_spy_ptr->result_summary.type == "wrong_move");
+    CHECK(notifier_spy_ptr->result_summary.winner == PlayerColor::light);
+}
+
+TEST_CASE("StaticGame works with a SearchPlayer on a BitBoard.")
+{
+    auto search_player
+        = std::make_shared<SearchPlayer<BitBoard>>("search", SearchLimits{.max_depth = 2});
+    auto random_player = std::make_shared<RandomPlayer>("random", 3);
+    auto game = StaticGame<BitBoard, SearchPlayer<BitBoard>, RandomPlayer>{
+        search_player, random_player, std::make_unique<SpyForNotifierOutput>()};
+
+    game.new_game(true);
+    game.run_game_loop();
+
+    REQUIRE(game.get_result() != nullptr);
+    CHECK(game.get_board().compute_score().get_num_empty_fields() < 60);
+    CHECK(search_player->get_color() == PlayerColor::light);
+    CHECK(search_player->get_total_statistics().nodes > 0);
+}
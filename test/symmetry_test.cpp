@@ -0,0 +1,96 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "symmetry.hpp"
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "board.hpp"
+#include "doctest.hpp"
+
+namespace reviser {
+
+TEST_CASE("transform_position()")
+{
+    const auto pos = Position{Row{1}, Column{2}};
+    CHECK(transform_position(pos, Symmetry::identity) == pos);
+    CHECK(transform_position(pos, Symmetry::rotate_90) == Position{Row{2}, Column{6}});
+    CHECK(transform_position(pos, Symmetry::rotate_180) == Position{Row{6}, Column{5}});
+    CHECK(transform_position(pos, Symmetry::rotate_270) == Position{Row{5}, Column{1}});
+    CHECK(transform_position(pos, Symmetry::flip_vertical) == Position{Row{6}, Column{2}});
+    CHECK(transform_position(pos, Symmetry::flip_horizontal) == Position{Row{1}, Column{5}});
+    CHECK(transform_position(pos, Symmetry::flip_diagonal) == Position{Row{2}, Column{1}});
+    CHECK(
+        transform_position(pos, Symmetry::flip_anti_diagonal) == Position{Row{5}, Column{6}});
+
+    for (const auto symmetry : all_symmetries) {
+        for (const auto p : all_board_positions()) {
+            CHECK(transform_position(transform_position(p, symmetry), inverse(symmetry)) == p);
+        }
+    }
+}
+
+TEST_CASE("transform_bits() agrees with transform_position()")
+{
+    for (const auto symmetry : all_symmetries) {
+        for (const auto pos : all_board_positions()) {
+            CHECK(
+                transform_bits(position_bit(pos), symmetry)
+                == position_bit(transform_position(pos, symmetry)));
+        }
+        constexpr Bits bits{0x0123'4567'89ab'cdef};
+        CHECK(transform_bits(transform_bits(bits, symmetry), inverse(symmetry)) == bits);
+    }
+}
+
+namespace {
+
+const auto board_string = "|*|O|O|O| | | | |\n"
+                          "| |*| | | | | | |\n"
+                          "| | | |O| | | | |\n"
+                          "| | | |O|O| | | |\n"
+                          "| | | |O|*| | | |\n"
+                          "| | | | | | | | |\n"
+                          "| |*|O|*|O|*|O| |\n"
+                          "| | |*|O|*|O| | |";
+
+} // namespace
+
+TEST_CASE_TEMPLATE("Board transforms", BoardT, ArrayBoard, BitBoard)
+{
+    const auto board = BoardT::from_string(board_string);
+
+    for (const auto symmetry : all_symmetries) {
+        const auto transformed_board = board.transform(symmetry);
+        for (const auto pos : all_board_positions()) {
+            CHECK(transformed_board[transform_position(pos, symmetry)] == board[pos]);
+        }
+        CHECK(
+            transformed_board.get_hash(PlayerColor::light)
+            == compute_zobrist_hash(transformed_board, PlayerColor::light));
+        CHECK(
+            transformed_board.compute_score().get_num_dark_fields()
+            == board.compute_score().get_num_dark_fields());
+        CHECK(transformed_board.transform(inverse(symmetry)) == board);
+    }
+}
+
+TEST_CASE_TEMPLATE("canonical_form()", BoardT, ArrayBoard, BitBoard)
+{
+    const auto board = BoardT::from_string(board_string);
+    const auto [canonical_board, symmetry] = canonical_form(board);
+
+    CHECK(canonical_board == board.transform(symmetry));
+    for (const auto other_symmetry : all_symmetries) {
+        CHECK(canonical_form(board.transform(other_symmetry)).board == canonical_board);
+    }
+    CHECK(
+        canonical_board.to_string()
+        == canonical_form(copy_board_as<BitBoard>(board)).board.to_string());
+
+    // Moves in the canonical form are mapped back to valid moves of the board.
+    for (const auto move : canonical_board.find_valid_moves(PlayerColor::dark)) {
+        CHECK(board.is_valid_move(PlayerColor::dark, transform_position(move, inverse(symmetry))));
+    }
+}
+
+} // namespace reviser
@@ -0,0 +1,116 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "transposition_table.hpp"
+
+#include <bit>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bit_board.hpp"
+#include "doctest.hpp"
+#include "search.hpp"
+
+using namespace reviser;
+using namespace reviser::ai;
+
+TEST_CASE("TranspositionTable uses a power-of-two number of buckets within its budget.")
+{
+    const auto table = TranspositionTable{3};
+
+    CHECK(table.get_size_in_bytes() <= 3 * 1024 * 1024);
+    CHECK(table.get_size_in_bytes() == 2 * 1024 * 1024);
+    CHECK(std::has_single_bit(table.get_num_entries()));
+}
+
+TEST_CASE("TranspositionTable::probe() returns stored entries.")
+{
+    auto table = TranspositionTable{1};
+    const auto entry = TranspositionEntry{-1234, 7, Bound::lower, Position{Row{2}, Column{3}}};
+    const auto entry_without_move = TranspositionEntry{0, 0, Bound::exact, std::nullopt};
+
+    CHECK_FALSE(table.probe(0x1234).has_value());
+    table.store(0x1234, entry);
+    table.store(0x5678, entry_without_move);
+
+    CHECK(table.probe(0x1234) == entry);
+    CHECK(table.probe(0x5678) == entry_without_move);
+    CHECK_FALSE(table.probe(0x9abc).has_value());
+
+    table.clear();
+    CHECK_FALSE(table.probe(0x1234).has_value());
+}
+
+TEST_CASE("TranspositionTable replaces the shallowest entry of a bucket.")
+{
+    auto table = TranspositionTable{1};
+    const auto stride = ZobristHash{table.get_num_entries() / 4};
+    for (auto i = 0u; i < 4; ++i) {
+        table.store(i * stride, {static_cast<int>(i), 10 - static_cast<int>(i), Bound::exact});
+    }
+    // Updating an existing entry does not evict other entries.
+    table.store(0, {100, 1, Bound::upper});
+    CHECK(table.probe(0)->score == 100);
+
+    table.store(4 * stride, {4, 5, Bound::exact});
+
+    CHECK_FALSE(table.probe(0).has_value());
+    for (auto i = 1u; i <= 4; ++i) {
+        CHECK(table.probe(i * stride).has_value());
+    }
+}
+
+TEST_CASE("TranspositionTable prefers replacing entries of earlier searches.")
+{
+    auto table = TranspositionTable{1};
+    const auto stride = ZobristHash{table.get_num_entries() / 4};
+    table.store(0, {0, 20, Bound::exact});
+    table.new_search();
+    for (auto i = 1u; i < 4; ++i) {
+        table.store(i * stride, {0, 1, Bound::exact});
+    }
+
+    table.store(4 * stride, {0, 1, Bound::exact});
+
+    CHECK_FALSE(table.probe(0).has_value());
+    CHECK(table.probe(4 * stride).has_value());
+}
+
+TEST_CASE("TranspositionTable can be shared between threads.")
+{
+    auto table = TranspositionTable{1};
+    auto threads = std::vector<std::jthread>{};
+    for (auto t = 0; t < 4; ++t) {
+        threads.emplace_back([&table, t] {
+            for (auto i = 0; i < 100'000; ++i) {
+                const auto hash = ZobristHash{static_cast<std::uint64_t>(i % 1000) * 31};
+                const auto depth = i % 1000 % 60;
+                if ((i + t) % 2 == 0) {
+                    table.store(hash, {i % 1000, depth, Bound::exact});
+                }
+                else if (const auto entry = table.probe(hash)) {
+                    // Entries for a hash are only ever written with the same contents.
+                    CHECK(entry->score == i % 1000);
+                    CHECK(entry->depth == depth);
+                }
+            }
+        });
+    }
+}
+
+TEST_CASE("AlphaBetaSearch with a transposition table computes the same value.")
+{
+    auto board = BitBoard{};
+    board.initialize();
+    auto table = std::make_shared<TranspositionTable>(1);
+
+    auto search = AlphaBetaSearch<BitBoard>{SearchLimits{.max_depth = 5}};
+    auto search_with_table = AlphaBetaSearch<BitBoard>{SearchLimits{.max_depth = 5}, table};
+    const auto result = search.search(board, PlayerColor::dark);
+    const auto result_with_table = search_with_table.search(board, PlayerColor::dark);
+
+    CHECK(result_with_table.score == result.score);
+    CHECK(result_with_table.statistics.nodes < result.statistics.nodes);
+    REQUIRE(result_with_table.best_move.has_value());
+    CHECK(board.is_valid_move(PlayerColor::dark, *result_with_table.best_move));
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "work_stealing_deque.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "doctest.hpp"
+
+using namespace reviser::ai;
+
+TEST_CASE("WorkStealingDeque pops the newest and steals the oldest element.")
+{
+    auto values = std::vector<int>{1, 2, 3};
+    auto deque = WorkStealingDeque<int>{4};
+    CHECK(deque.empty());
+    CHECK(deque.pop() == nullptr);
+    CHECK(deque.steal() == nullptr);
+
+    for (auto& value : values) {
+        CHECK(deque.push(&value));
+    }
+
+    CHECK(deque.pop() == &values[2]);
+    CHECK(deque.steal() == &values[0]);
+    CHECK(deque.pop() == &values[1]);
+    CHECK(deque.empty());
+}
+
+TEST_CASE("WorkStealingDeque rejects pushes when it is full.")
+{
+    auto values = std::vector<int>(5);
+    auto deque = WorkStealingDeque<int>{3};
+    REQUIRE(deque.get_capacity() == 4);
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        CHECK(deque.push(&values[i]));
+    }
+    CHECK_FALSE(deque.push(&values[4]));
+
+    CHECK(deque.steal() == &values[0]);
+    CHECK(deque.push(&values[4]));
+}
+
+TEST_CASE("WorkStealingDeque hands out every element exactly once.")
+{
+    constexpr std::size_t num_values{20'000};
+    constexpr std::size_t num_thieves{3};
+    auto values = std::vector<int>(num_values);
+    auto times_taken = std::vector<std::atomic<int>>(num_values);
+    auto deque = WorkStealingDeque<int>{64};
+    auto is_done = std::atomic<bool>{false};
+    const auto take = [&](const int* value) { ++times_taken[value - values.data()]; };
+
+    {
+        auto thieves = std::vector<std::jthread>{};
+        for (std::size_t i = 0; i < num_thieves; ++i) {
+            thieves.emplace_back([&] {
+                while (!is_done.load()) {
+                    if (const auto* value = deque.steal()) {
+                        take(value);
+                    }
+                }
+            });
+        }
+        for (std::size_t i = 0; i < num_values; ++i) {
+            while (!deque.push(&values[i])) {
+                if (const auto* value = deque.pop()) {
+                    take(value);
+                }
+            }
+            if (i % 3 == 0) {
+                if (const auto* value = deque.pop()) {
+                    take(value);
+                }
+            }
+        }
+        while (const auto* value = deque.pop()) {
+            take(value);
+        }
+        is_done.store(true);
+    }
+
+    auto num_wrong = 0;
+    for (const auto& count : times_taken) {
+        num_wrong += count.load() != 1 ? 1 : 0;
+    }
+    CHECK(num_wrong == 0);
+}
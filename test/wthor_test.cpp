@@ -0,0 +1,138 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "wthor.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "doctest.hpp"
+#include "game_record.hpp"
+
+namespace reviser {
+
+namespace {
+
+// Dark has to pass before the last move.
+const auto moves_with_pass = std::vector<std::uint8_t>{20, 21, 22, 14, 34, 23, 7, 5, 19};
+
+std::vector<std::uint8_t> make_wthor_data(const std::vector<std::vector<std::uint8_t>>& games)
+{
+    auto data = std::vector<std::uint8_t>(wthor_header_size);
+    data[4] = static_cast<std::uint8_t>(games.size());
+    data[10] = 2024 & 0xff;
+    data[11] = 2024 >> 8;
+    data[12] = 8;
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        auto game = std::vector<std::uint8_t>(wthor_game_size);
+        game[0] = 7;
+        game[2] = static_cast<std::uint8_t>(i + 1);
+        game[4] = 1;
+        game[5] = 1;
+        game[6] = 40;
+        game[7] = 36;
+        std::ranges::transform(games[i], game.begin() + 8, [](const std::uint8_t index) {
+            return position_to_wthor_move(Position::from_linear_index(index));
+        });
+        data.insert(data.end(), game.begin(), game.end());
+    }
+    return data;
+}
+
+} // namespace
+
+TEST_CASE("wthor_move_to_position()")
+{
+    // The usual first move f5 is the mirror image of our first move at (4, 2).
+    CHECK(wthor_move_to_position(56) == Position{Row{4}, Column{2}});
+    CHECK(wthor_move_to_position(11) == Position{Row{0}, Column{7}});
+    CHECK(wthor_move_to_position(88) == Position{Row{7}, Column{0}});
+    CHECK_THROWS_AS((void)wthor_move_to_position(0), std::invalid_argument);
+    CHECK_THROWS_AS((void)wthor_move_to_position(19), std::invalid_argument);
+
+    for (const auto pos : all_board_positions()) {
+        CHECK(wthor_move_to_position(position_to_wthor_move(pos)) == pos);
+    }
+}
+
+TEST_CASE("WthorDatabase")
+{
+    const auto data = make_wthor_data({{34, 43, 42}, moves_with_pass});
+    const auto database = WthorDatabase{data};
+
+    REQUIRE(database.size() == 2);
+    CHECK(database.get_year() == 2024);
+    CHECK(std::ranges::size(database.get_games()) == 2);
+
+    const auto game = database[1];
+    CHECK(game.get_tournament_id() == 7);
+    CHECK(game.get_dark_player_id() == 2);
+    CHECK(game.get_light_player_id() == 257);
+    CHECK(game.get_num_dark_discs() == 40);
+    CHECK(game.get_theoretical_num_dark_discs() == 36);
+    CHECK(game.get_num_moves() == moves_with_pass.size());
+    CHECK(game.get_move(0) == Position::from_linear_index(20));
+    CHECK_THROWS_AS((void)database.at(2), std::invalid_argument);
+
+    SUBCASE("replaying games inserts passes")
+    {
+        auto record = GameRecord{};
+        record.moves = moves_with_pass;
+        record.moves.insert(record.moves.end() - 1, game_record_pass);
+        auto expected_board = ArrayBoard{};
+        replay_game_record(record, expected_board);
+
+        auto array_board = ArrayBoard{};
+        CHECK(replay_wthor_game(game, array_board) == PlayerColor::dark);
+        CHECK(array_board == expected_board);
+
+        auto bit_board = BitBoard{};
+        replay_wthor_game(database.get_games()[1], bit_board);
+        CHECK(bit_board.to_string() == expected_board.to_string());
+    }
+
+    SUBCASE("invalid moves")
+    {
+        auto invalid_data = data;
+        invalid_data[wthor_header_size + 8] = position_to_wthor_move(Position{Row{0}, Column{0}});
+        const auto invalid_database = WthorDatabase{invalid_data};
+        auto board = BitBoard{};
+        CHECK_THROWS_AS(replay_wthor_game(invalid_database[0], board), std::invalid_argument);
+    }
+}
+
+TEST_CASE("WthorDatabase rejects invalid files")
+{
+    auto data = make_wthor_data({{34}});
+    CHECK_THROWS_AS(
+        WthorDatabase{std::span{data}.first(wthor_header_size - 1)}, std::invalid_argument);
+    CHECK_THROWS_AS(
+        WthorDatabase{std::span{data}.first(data.size() - 1)}, std::invalid_argument);
+    data[12] = 10;
+    CHECK_THROWS_AS(WthorDatabase{data}, std::invalid_argument);
+}
+
+TEST_CASE("WthorDatabase maps files")
+{
+    const auto path = std::filesystem::temp_directory_path() / "reviser_wthor_test.wtb";
+    const auto data = make_wthor_data({moves_with_pass, {34}});
+    {
+        auto out = std::ofstream{path, std::ios::binary};
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<long>(data.size()));
+    }
+
+    {
+        const auto database = WthorDatabase{path};
+        REQUIRE(database.size() == 2);
+        CHECK(database[0].get_num_moves() == moves_with_pass.size());
+        CHECK(database[1].get_move(0) == Position::from_linear_index(34));
+    }
+    std::filesystem::remove(path);
+
+    CHECK_THROWS_AS(WthorDatabase{path}, std::invalid_argument);
+}
+
+} // namespace reviser
@@ -0,0 +1,109 @@
+// Copyright (c) 2024 Dr. Matthias Hölzl.
+
+#include "zobrist.hpp"
+
+#include <random>
+#include <set>
+#include <vector>
+
+#include "array_board.hpp"
+#include "bit_board.hpp"
+#include "doctest.hpp"
+
+using reviser::ArrayBoard;
+using reviser::BitBoard;
+using reviser::Column;
+using reviser::compute_zobrist_hash;
+using reviser::Field;
+using reviser::FlipRecord;
+using reviser::InitialBoardState;
+using reviser::other_player_color;
+using reviser::PlayerColor;
+using reviser::Position;
+using reviser::Row;
+using reviser::ZobristHash;
+
+TEST_CASE_TEMPLATE("Board hashes depend on the side to move.", BoardT, ArrayBoard, BitBoard)
+{
+    auto board = BoardT{};
+    board.initialize();
+
+    CHECK(board.get_hash(PlayerColor::dark) != board.get_hash(PlayerColor::light));
+    CHECK(board.get_hash(PlayerColor::dark) == compute_zobrist_hash(board, PlayerColor::dark));
+    CHECK(
+        board.get_hash(PlayerColor::light) == compute_zobrist_hash(board, PlayerColor::light));
+}
+
+TEST_CASE_TEMPLATE("Board hashes are maintained by set_field().", BoardT, ArrayBoard, BitBoard)
+{
+    auto board = BoardT{};
+    board.initialize(InitialBoardState::empty);
+    const auto empty_hash = board.get_hash(PlayerColor::dark);
+    const auto pos = Position{Row{2}, Column{5}};
+
+    board[pos] = Field::dark;
+    CHECK(board.get_hash(PlayerColor::dark) == compute_zobrist_hash(board, PlayerColor::dark));
+    board[pos] = Field::light;
+    CHECK(board.get_hash(PlayerColor::dark) == compute_zobrist_hash(board, PlayerColor::dark));
+    board[pos] = Field::empty;
+    CHECK(board.get_hash(PlayerColor::dark) == empty_hash);
+}
+
+TEST_CASE_TEMPLATE(
+    "Board hashes are maintained by play_move() and undo_move().", BoardT, ArrayBoard, BitBoard)
+{
+    auto rng = std::mt19937{42};
+    for (auto game = 0; game < 20; ++game) {
+        auto board = BoardT{};
+        board.initialize();
+        auto pc = PlayerColor::dark;
+        auto records = std::vector<FlipRecord>{};
+        auto hashes = std::vector<ZobristHash>{};
+        auto num_passes = 0;
+        while (num_passes < 2) {
+            const auto moves = board.find_valid_moves(pc);
+            if (moves.empty()) {
+                ++num_passes;
+            }
+            else {
+                num_passes = 0;
+                auto it = moves.begin();
+                std::advance(it, rng() % moves.size());
+                hashes.push_back(board.get_hash(pc));
+                records.push_back(board.play_move(pc, *it));
+            }
+            pc = other_player_color(pc);
+            REQUIRE(board.get_hash(pc) == compute_zobrist_hash(board, pc));
+        }
+        while (!records.empty()) {
+            board.undo_move(records.back());
+            CHECK(board.get_hash(records.back().player_color) == hashes.back());
+            records.pop_back();
+            hashes.pop_back();
+        }
+    }
+}
+
+TEST_CASE("ArrayBoard and BitBoard compute the same hashes.")
+{
+    auto array_board = ArrayBoard{};
+    array_board.initialize();
+    auto bit_board = BitBoard{};
+    bit_board.initialize();
+    const auto move = Position{Row{2}, Column{4}};
+
+    array_board.play_move(PlayerColor::dark, move);
+    bit_board.play_move(PlayerColor::dark, move);
+
+    CHECK(array_board.get_hash(PlayerColor::light) == bit_board.get_hash(PlayerColor::light));
+}
+
+TEST_CASE("Zobrist keys are distinct.")
+{
+    auto keys = std::set<ZobristHash>{reviser::zobrist_keys.light_to_move};
+    for (auto i = 0u; i < 64; ++i) {
+        keys.insert(reviser::zobrist_keys.dark_fields[i]);
+        keys.insert(reviser::zobrist_keys.light_fields[i]);
+    }
+    CHECK(keys.size() == 129);
+}